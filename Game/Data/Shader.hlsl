@@ -4,14 +4,11 @@ cbuffer cbPerFrame : register(b0)
     matrix g_projection;
 };
 
-cbuffer cbPerObject : register(b1)
-{
-    matrix g_world;
-};
-
 struct VertexShaderInput
 {
     float3 pos : POSITION;
+    float2 instancePos : INSTANCEPOS;
+    float2 instanceScale : INSTANCESCALE;
 };
 
 struct VertexShaderOutput
@@ -22,8 +19,7 @@ struct VertexShaderOutput
 VertexShaderOutput VSMain(VertexShaderInput input)
 {
     VertexShaderOutput output;
-    output.pos = float4(input.pos, 1.0f);
-    output.pos = mul(output.pos, g_world);
+    output.pos = float4(input.pos.xy * input.instanceScale + input.instancePos, input.pos.z, 1.0f);
     output.pos = mul(output.pos, g_view);
     output.pos = mul(output.pos, g_projection);
     
@@ -4,11 +4,6 @@ cbuffer cbPerFrame : register(b0)
     matrix g_projection;
 };
 
-cbuffer cbPerObject : register(b1)
-{
-    matrix g_world;
-};
-
 Texture2D g_txFontAtlas : register(t0);
 
 SamplerState g_samplerLinear : register(s0);
@@ -29,7 +24,6 @@ VertexShaderOutput VSMain(VertexShaderInput input)
 {
     VertexShaderOutput output;
     output.pos = float4(input.pos, 1.0f);
-    output.pos = mul(output.pos, g_world);
     output.pos = mul(output.pos, g_view);
     output.pos = mul(output.pos, g_projection);
     output.texCoord = input.texCoord;
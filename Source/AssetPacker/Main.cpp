@@ -0,0 +1,52 @@
+#include <chrono>
+#include <cstdio>
+#include "Assets/AssetPack.h"
+
+// Packs the game's data files into the one asset pack the game maps at startup. Assets are named by
+// the paths given, so run it from the data directory.
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: AssetPacker <output .pack> <file>...\n");
+        return 1;
+    }
+
+    AssetPackWriter writer;
+    for (int i = 2; i < argc; ++i)
+    {
+        if (!writer.AddFile(argv[i], argv[i]))
+        {
+            fprintf(stderr, "Couldn't add %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (!writer.Write(argv[1]))
+    {
+        fprintf(stderr, "Couldn't write %s\n", argv[1]);
+        return 1;
+    }
+
+    // Opened the way the game does, and every hash checked
+    std::chrono::steady_clock::time_point opening = std::chrono::steady_clock::now();
+    AssetPack pack;
+    bool opened = pack.Open(argv[1]);
+    std::chrono::steady_clock::time_point openedTime = std::chrono::steady_clock::now();
+
+    if (!opened || pack.GetNumAssets() != (size_t)(argc - 2) || !pack.Verify())
+    {
+        fprintf(stderr, "%s doesn't open as an asset pack\n", argv[1]);
+        return 1;
+    }
+
+    uint64_t totalSize = 0;
+    for (size_t i = 0; i < pack.GetNumAssets(); ++i)
+        totalSize += pack.GetEntry(i).size;
+
+    printf("%s: %zu assets, %llu bytes, opens in %.1f us\n", argv[1], pack.GetNumAssets(),
+        (unsigned long long)totalSize, std::chrono::duration<double>(openedTime - opening).count() * 1e6);
+
+    return 0;
+}
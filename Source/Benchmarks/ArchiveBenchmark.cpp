@@ -0,0 +1,156 @@
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <vector>
+#include "Platform/File.h"
+#include "Replay/Replay.h"
+#include "Replay/ReplayArchive.h"
+#include "Benchmarks.h"
+
+static const char* ArchiveBenchmarkFilename = "ArchiveBenchmark.tmp";
+static const char* ArchiveBenchmarkSessionsFilename = "ArchiveBenchmarkSessions.tmp";
+
+void RunArchiveBenchmark()
+{
+    const int numDistinctMatches = 256;
+    const int numMatches = 200000;
+
+    std::vector<std::vector<uint8_t>> replays;
+    for (int i = 0; i < numDistinctMatches; ++i)
+        replays.push_back(RecordBenchmarkMatch(2000 + i, ReplayWriter::DefaultKeyframeInterval));
+
+    remove(ArchiveBenchmarkFilename);
+
+    // Written in two sessions, to cover appending to an existing archive
+    BenchmarkTimer writeTimer;
+    bool ok = true;
+    for (int session = 0; session < 2; ++session)
+    {
+        ReplayArchiveWriter writer;
+        ok &= writer.Open(ArchiveBenchmarkFilename);
+        for (int i = 0; i < numMatches / 2; ++i)
+        {
+            const std::vector<uint8_t>& replay = replays[writer.GetNextMatchId() % numDistinctMatches];
+            ok &= writer.Append(writer.GetNextMatchId(), replay.data(), replay.size());
+        }
+        ok &= writer.Close();
+    }
+    double writeSeconds = writeTimer.GetElapsedSeconds();
+
+    BenchmarkTimer openTimer;
+    ReplayArchive archive;
+    ok &= archive.Open(ArchiveBenchmarkFilename);
+    double openSeconds = openTimer.GetElapsedSeconds();
+    ok &= (archive.GetNumMatches() == numMatches);
+
+    printf("write: %d matches in %.3f s, open: %.1f us%s\n", numMatches, writeSeconds, openSeconds * 1e6, ok ? "" : " FAILED");
+    if (!ok)
+    {
+        remove(ArchiveBenchmarkFilename);
+        return;
+    }
+
+    // Index only query: matches won by paddle 2 that lasted over 5 seconds
+    BenchmarkTimer scanTimer;
+    size_t numFound = 0;
+    double totalSeconds = 0.0;
+    for (size_t i = 0; i < archive.GetNumMatches(); ++i)
+    {
+        const ReplayArchiveEntry& entry = archive.GetEntry(i);
+        totalSeconds += entry.durationSeconds;
+        if (entry.paddleScore2 > entry.paddleScore1 && entry.durationSeconds > 5.0f)
+            ++numFound;
+    }
+    double scanSeconds = scanTimer.GetElapsedSeconds();
+
+    printf("index scan: %.1f M matches/s (%zu matches found, %.1f hours of play)\n",
+        archive.GetNumMatches() / scanSeconds / 1e6, numFound, totalSeconds / 3600.0);
+
+    // Random access: look matches up by id and verify their replays
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint64_t> matchId(1, numMatches);
+
+    const int numLookups = 2000;
+    int numVerified = 0;
+    BenchmarkTimer lookupTimer;
+    for (int i = 0; i < numLookups; ++i)
+    {
+        ptrdiff_t index = archive.FindMatch(matchId(rng));
+        if (index < 0)
+            continue;
+
+        const ReplayArchiveEntry& entry = archive.GetEntry(index);
+        ReplayPlayer player;
+        if (player.Open(archive.GetReplayData(entry), entry.size) && player.Verify())
+            ++numVerified;
+    }
+    double lookupSeconds = lookupTimer.GetElapsedSeconds();
+
+    printf("lookup + verify: %.1f us/match, %d/%d verified\n", lookupSeconds / numLookups * 1e6, numVerified, numLookups);
+
+    archive.Close();
+
+    // A session killed after appending a replay but before writing the index leaves records without an
+    // index after them, here followed by the start of a record that never completed. The next session has
+    // to rebuild the index from the records and append after the last complete one.
+    FILE* pFile = OpenStdioFile(ArchiveBenchmarkFilename, "ab");
+    ok &= pFile != nullptr && fwrite(replays[0].data(), 1, replays[0].size(), pFile) == replays[0].size();
+    if (pFile != nullptr)
+        fclose(pFile);
+
+    ReplayArchiveWriter recoveryWriter;
+    ok &= recoveryWriter.Open(ArchiveBenchmarkFilename) && recoveryWriter.GetNumMatches() == numMatches;
+    ok &= recoveryWriter.Append(recoveryWriter.GetNextMatchId(), replays[1].data(), replays[1].size());
+    ok &= recoveryWriter.Close();
+
+    ok &= archive.Open(ArchiveBenchmarkFilename) && archive.GetNumMatches() == numMatches + 1;
+    if (ok)
+    {
+        const ReplayArchiveEntry& entry = archive.GetEntry(numMatches);
+        ReplayPlayer player;
+        ok &= player.Open(archive.GetReplayData(entry), entry.size) && player.Verify();
+    }
+
+    // Killed while writing the index: readers rebuild it from the records too
+    archive.Close();
+    std::error_code error;
+    std::filesystem::resize_file(ArchiveBenchmarkFilename, std::filesystem::file_size(ArchiveBenchmarkFilename) - 100, error);
+    ok &= !error && archive.Open(ArchiveBenchmarkFilename) && archive.GetNumMatches() == numMatches + 1;
+    printf("recovery from an interrupted session:%s\n", ok ? " ok" : " FAILED");
+
+    archive.Close();
+    remove(ArchiveBenchmarkFilename);
+
+    // The game appends one match per run. Every session has to replace the index, not add another one, so
+    // the archive ends up the same size as if all matches had been written in one session.
+    const int numSessions = 1000;
+    remove(ArchiveBenchmarkSessionsFilename);
+    BenchmarkTimer sessionTimer;
+    for (int session = 0; session < numSessions; ++session)
+    {
+        ReplayArchiveWriter writer;
+        ok &= writer.Open(ArchiveBenchmarkSessionsFilename);
+        const std::vector<uint8_t>& replay = replays[session % numDistinctMatches];
+        ok &= writer.Append(writer.GetNextMatchId(), replay.data(), replay.size());
+        ok &= writer.Close();
+    }
+    double sessionSeconds = sessionTimer.GetElapsedSeconds();
+    uintmax_t sessionsSize = std::filesystem::file_size(ArchiveBenchmarkSessionsFilename, error);
+
+    ReplayArchiveWriter singleWriter;
+    ok &= singleWriter.Open(ArchiveBenchmarkFilename);
+    for (int i = 0; i < numSessions; ++i)
+        ok &= singleWriter.Append(singleWriter.GetNextMatchId(), replays[i % numDistinctMatches].data(), replays[i % numDistinctMatches].size());
+    ok &= singleWriter.Close();
+    uintmax_t singleSize = std::filesystem::file_size(ArchiveBenchmarkFilename, error);
+
+    ok &= archive.Open(ArchiveBenchmarkSessionsFilename) && archive.GetNumMatches() == numSessions;
+    ok &= (sessionsSize == singleSize);
+    printf("%d one-match sessions: %.1f us per session, %ju KB (%ju KB in one session)%s\n", numSessions,
+        sessionSeconds / numSessions * 1e6, sessionsSize / 1024, singleSize / 1024, ok ? "" : " FAILED");
+
+    archive.Close();
+    remove(ArchiveBenchmarkFilename);
+    remove(ArchiveBenchmarkSessionsFilename);
+}
@@ -0,0 +1,117 @@
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Assets/AssetPack.h"
+#include "Assets/AssetLoader.h"
+#include "Platform/Hash.h"
+#include "Threading/JobSystem.h"
+#include "Benchmarks.h"
+
+static const char* AssetLoaderBenchmarkFilename = "AssetLoaderBenchmark.tmp";
+static const int NumLoaderAssets = 32;
+static const size_t LoaderAssetSize = 256 * 1024;
+static const int NumLoads = 10;
+
+// Stands in for decoding an asset (e.g. a texture or a sound): a few passes over every byte
+static uint64_t DecodeAsset(const uint8_t* pData, size_t size)
+{
+    uint64_t hash = Fnv1aBasis;
+    for (int pass = 0; pass < 4; ++pass)
+        hash = HashFnv1a(pData, size, hash);
+
+    return hash;
+}
+
+static std::string GetAssetName(int index)
+{
+    return "Asset" + std::to_string(index) + ".bin";
+}
+
+// Decodes and finalizes every asset one after the other, as GameApp::Initialize() did
+static bool LoadSerial(const AssetPack& pack, std::vector<uint64_t>& outDecoded)
+{
+    for (int i = 0; i < NumLoaderAssets; ++i)
+    {
+        const uint8_t* pData = nullptr;
+        size_t size = 0;
+        if (!pack.FindAsset(GetAssetName(i).c_str(), pData, size))
+            return false;
+
+        outDecoded[i] = DecodeAsset(pData, size);
+    }
+
+    return true;
+}
+
+// Decodes on the job system while this thread polls, as GameApp::Run() does between loading frames
+static bool LoadAsync(const AssetPack& pack, JobSystem* pJobs, std::vector<uint64_t>& outDecoded, int& outNumPolls)
+{
+    std::vector<uint64_t> decoded(NumLoaderAssets);
+    bool ok = true;
+
+    AssetLoader loader(pJobs, &pack);
+    for (int i = 0; i < NumLoaderAssets; ++i)
+    {
+        ok &= loader.Add(GetAssetName(i).c_str(),
+            [&decoded, i](const uint8_t* pData, size_t size) { decoded[i] = DecodeAsset(pData, size); return true; },
+            [&decoded, &outDecoded, i]() { outDecoded[i] = decoded[i]; return true; });
+    }
+
+    loader.Start();
+
+    float lastProgress = 0.0f;
+    outNumPolls = 0;
+    while (ok && !loader.IsDone())
+    {
+        ok &= loader.Update();
+
+        float progress = loader.GetProgress();
+        ok &= progress >= lastProgress && progress <= 1.0f;
+        lastProgress = progress;
+        ++outNumPolls;
+    }
+
+    return ok && loader.GetProgress() == 1.0f;
+}
+
+void RunAssetLoaderBenchmark()
+{
+    AssetPackWriter writer;
+    bool ok = true;
+    for (int i = 0; i < NumLoaderAssets; ++i)
+    {
+        std::vector<uint8_t> data(LoaderAssetSize);
+        for (size_t j = 0; j < data.size(); ++j)
+            data[j] = (uint8_t)(j * 7 + i);
+
+        ok &= writer.Add(GetAssetName(i).c_str(), data.data(), data.size());
+    }
+    ok &= writer.Write(AssetLoaderBenchmarkFilename);
+
+    AssetPack pack;
+    ok &= pack.Open(AssetLoaderBenchmarkFilename);
+
+    std::vector<uint64_t> serialDecoded(NumLoaderAssets);
+    BenchmarkTimer serialTimer;
+    for (int load = 0; load < NumLoads; ++load)
+        ok &= LoadSerial(pack, serialDecoded);
+    double serialSeconds = serialTimer.GetElapsedSeconds() / NumLoads;
+
+    JobSystem jobs;
+    std::vector<uint64_t> asyncDecoded(NumLoaderAssets);
+    int numPolls = 0;
+    BenchmarkTimer asyncTimer;
+    for (int load = 0; load < NumLoads; ++load)
+        ok &= LoadAsync(pack, &jobs, asyncDecoded, numPolls);
+    double asyncSeconds = asyncTimer.GetElapsedSeconds() / NumLoads;
+    ok &= (asyncDecoded == serialDecoded);
+
+    printf("%d assets of %zu KB, decoded serially:  %7.2f ms per load\n", NumLoaderAssets, LoaderAssetSize / 1024,
+        serialSeconds * 1e3);
+    printf("%d assets of %zu KB, AssetLoader:       %7.2f ms per load (%.1fx, %d polls)%s\n", NumLoaderAssets,
+        LoaderAssetSize / 1024, asyncSeconds * 1e3, serialSeconds / asyncSeconds, numPolls, ok ? "" : " FAILED");
+
+    pack.Close();
+    remove(AssetLoaderBenchmarkFilename);
+}
@@ -0,0 +1,127 @@
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Assets/AssetPack.h"
+#include "Platform/File.h"
+#include "Benchmarks.h"
+
+static const char* AssetPackBenchmarkFilename = "AssetPackBenchmark.tmp";
+static const int NumAssetLoads = 2000;
+
+struct BenchmarkAsset
+{
+    const char*     name;
+    size_t          size;
+};
+
+// The game's data files and their sizes
+static const BenchmarkAsset s_assets[] =
+{
+    { "FontAtlas.dds",      153792 },
+    { "FontAtlas.font",     9496 },
+    { "PaddleHit.wav",      3952 },
+    { "Shader.hlsl",        684 },
+    { "TextShader.hlsl",    820 },
+    { "WallHit.wav",        5806 },
+};
+
+static std::string GetLooseFilename(const BenchmarkAsset& asset)
+{
+    return std::string("AssetPackBenchmark.") + asset.name + ".tmp";
+}
+
+// How the game read each file before the pack: open, size, read into a buffer of its own
+static bool ReadLooseFile(const char* pFilename, std::vector<uint8_t>& outData)
+{
+    FILE* pFile = OpenStdioFile(pFilename, "rb");
+    if (pFile == nullptr)
+        return false;
+
+    fseek(pFile, 0, SEEK_END);
+    long size = ftell(pFile);
+    rewind(pFile);
+
+    outData.resize(size > 0 ? (size_t)size : 0);
+    bool ok = size > 0 && fread(outData.data(), 1, outData.size(), pFile) == outData.size();
+    fclose(pFile);
+
+    return ok;
+}
+
+// Reads every 64th byte, as a stand in for the loaders using the data
+static uint32_t TouchData(const uint8_t* pData, size_t size)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < size; i += 64)
+        sum += pData[i];
+
+    return sum;
+}
+
+void RunAssetPackBenchmark()
+{
+    AssetPackWriter writer;
+    bool ok = true;
+    for (const BenchmarkAsset& asset : s_assets)
+    {
+        std::vector<uint8_t> data(asset.size);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = (uint8_t)(i * 13 + asset.size);
+
+        FILE* pFile = OpenStdioFile(GetLooseFilename(asset).c_str(), "wb");
+        ok &= pFile != nullptr && fwrite(data.data(), 1, data.size(), pFile) == data.size();
+        if (pFile != nullptr)
+            fclose(pFile);
+
+        ok &= writer.Add(asset.name, data.data(), data.size());
+    }
+    ok &= writer.Write(AssetPackBenchmarkFilename);
+
+    uint32_t looseSum = 0;
+    BenchmarkTimer looseTimer;
+    for (int load = 0; load < NumAssetLoads; ++load)
+    {
+        for (const BenchmarkAsset& asset : s_assets)
+        {
+            std::vector<uint8_t> data;
+            ok &= ReadLooseFile(GetLooseFilename(asset).c_str(), data);
+            looseSum += TouchData(data.data(), data.size());
+        }
+    }
+    double looseSeconds = looseTimer.GetElapsedSeconds() / NumAssetLoads;
+
+    uint32_t packSum = 0;
+    BenchmarkTimer packTimer;
+    for (int load = 0; load < NumAssetLoads; ++load)
+    {
+        AssetPack pack;
+        ok &= pack.Open(AssetPackBenchmarkFilename);
+        for (const BenchmarkAsset& asset : s_assets)
+        {
+            const uint8_t* pData = nullptr;
+            size_t size = 0;
+            ok &= pack.FindAsset(asset.name, pData, size) && size == asset.size;
+            packSum += TouchData(pData, size);
+        }
+    }
+    double packSeconds = packTimer.GetElapsedSeconds() / NumAssetLoads;
+    ok &= (packSum == looseSum);
+
+    AssetPack pack;
+    ok &= pack.Open(AssetPackBenchmarkFilename);
+    BenchmarkTimer verifyTimer;
+    ok &= pack.Verify();
+    double verifySeconds = verifyTimer.GetElapsedSeconds();
+
+    const int numAssets = (int)(sizeof(s_assets) / sizeof(s_assets[0]));
+    printf("%d loose files, read into buffers: %7.1f us per load\n", numAssets, looseSeconds * 1e6);
+    printf("%d assets, mapped pack:            %7.1f us per load (%.1fx)\n", numAssets, packSeconds * 1e6,
+        looseSeconds / packSeconds);
+    printf("Verifying every hash:              %7.1f us%s\n", verifySeconds * 1e6, ok ? "" : " FAILED");
+
+    pack.Close();
+    remove(AssetPackBenchmarkFilename);
+    for (const BenchmarkAsset& asset : s_assets)
+        remove(GetLooseFilename(asset).c_str());
+}
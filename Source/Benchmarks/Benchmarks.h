@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <vector>
+
+// Each benchmark prints its own results to stdout. Run Benchmarks.exe with no arguments to run
+// all of them, or pass the names of the ones to run.
+
+void RunCollisionBenchmark();
+void RunMatchBatchBenchmark();
+void RunReplayBenchmark();
+void RunArchiveBenchmark();
+void RunEventQueueBenchmark();
+void RunJobSystemBenchmark();
+void RunPaddleAIBenchmark();
+void RunVectorEnvironmentBenchmark();
+void RunRenderBenchmark();
+void RunTextLayoutBenchmark();
+void RunSoftwareRenderBenchmark();
+void RunShaderCacheBenchmark();
+void RunAssetPackBenchmark();
+void RunAssetLoaderBenchmark();
+void RunWaveFileBenchmark();
+
+// Plays one match with a jittery human-like player on paddle 0 and the AI on paddle 1, and records it
+std::vector<uint8_t> RecordBenchmarkMatch(uint32_t seed, uint32_t keyframeInterval);
+
+class BenchmarkTimer
+{
+    std::chrono::high_resolution_clock::time_point m_start;
+
+public:
+    BenchmarkTimer() : m_start(std::chrono::high_resolution_clock::now()) {}
+
+    double GetElapsedSeconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_start).count();
+    }
+};
@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Simulation/CollisionKernel.h"
+#include "Benchmarks.h"
+
+using namespace CollisionKernel;
+
+// Random ball/paddle pairs placed around the paddles of a 640x480 field, so that a good share of them intersect
+struct PairData
+{
+    std::vector<float> ballMinX, ballMinY, ballMaxX, ballMaxY;
+    std::vector<float> paddleMinX, paddleMinY, paddleMaxX, paddleMaxY;
+
+    explicit PairData(size_t count)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> ballX(0.0f, 64.0f);
+        std::uniform_real_distribution<float> ballY(0.0f, 480.0f);
+        std::uniform_real_distribution<float> paddleY(30.0f, 450.0f);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float bx = ballX(rng);
+            float by = ballY(rng);
+            ballMinX.push_back(bx - 5.0f);
+            ballMinY.push_back(by - 5.0f);
+            ballMaxX.push_back(bx + 5.0f);
+            ballMaxY.push_back(by + 5.0f);
+
+            float py = paddleY(rng);
+            paddleMinX.push_back(27.0f);
+            paddleMinY.push_back(py - 30.0f);
+            paddleMaxX.push_back(37.0f);
+            paddleMaxY.push_back(py + 30.0f);
+        }
+    }
+
+    BallPaddlePairs GetPairs() const
+    {
+        BallPaddlePairs pairs;
+        pairs.ballMinX = ballMinX.data();
+        pairs.ballMinY = ballMinY.data();
+        pairs.ballMaxX = ballMaxX.data();
+        pairs.ballMaxY = ballMaxY.data();
+        pairs.paddleMinX = paddleMinX.data();
+        pairs.paddleMinY = paddleMinY.data();
+        pairs.paddleMaxX = paddleMaxX.data();
+        pairs.paddleMaxY = paddleMaxY.data();
+        return pairs;
+    }
+};
+
+struct ResultData
+{
+    std::vector<float> penetrationX, penetrationY;
+    std::vector<uint32_t> hit;
+
+    explicit ResultData(size_t count) : penetrationX(count), penetrationY(count), hit(count) {}
+
+    BallPaddleResults GetResults()
+    {
+        BallPaddleResults results;
+        results.penetrationX = penetrationX.data();
+        results.penetrationY = penetrationY.data();
+        results.hit = hit.data();
+        return results;
+    }
+
+    bool operator==(const ResultData& other) const
+    {
+        size_t count = hit.size();
+        return memcmp(penetrationX.data(), other.penetrationX.data(), count * sizeof(float)) == 0 &&
+            memcmp(penetrationY.data(), other.penetrationY.data(), count * sizeof(float)) == 0 &&
+            memcmp(hit.data(), other.hit.data(), count * sizeof(uint32_t)) == 0;
+    }
+};
+
+void RunCollisionBenchmark()
+{
+    const size_t numPairs = 4096 + 3; // Not a multiple of the vector width, so the scalar tail runs too
+    const int numIterations = 20000;
+
+    PairData data(numPairs);
+    BallPaddlePairs pairs = data.GetPairs();
+
+    ResultData reference(numPairs);
+    size_t referenceHits = ResolveBallPaddle(SimdLevel::Scalar, pairs, reference.GetResults(), numPairs);
+
+    printf("%zu pairs, %zu intersecting, best level: %s\n", numPairs, referenceHits, GetSimdLevelName(GetSimdLevel()));
+
+    for (int level = (int)SimdLevel::Scalar; level <= (int)GetSimdLevel(); ++level)
+    {
+        ResultData results(numPairs);
+        BallPaddleResults out = results.GetResults();
+
+        size_t hits = ResolveBallPaddle((SimdLevel)level, pairs, out, numPairs);
+        bool exact = (hits == referenceHits) && (results == reference);
+
+        size_t totalHits = 0;
+        BenchmarkTimer timer;
+        for (int i = 0; i < numIterations; ++i)
+            totalHits += ResolveBallPaddle((SimdLevel)level, pairs, out, numPairs);
+        double seconds = timer.GetElapsedSeconds();
+
+        double pairsPerSecond = (double)numPairs * numIterations / seconds;
+        printf("  %-6s %8.1f M pairs/s  %s  (%zu)\n", GetSimdLevelName((SimdLevel)level), pairsPerSecond / 1e6,
+            exact ? "matches scalar" : "MISMATCH", totalHits / numIterations);
+    }
+}
@@ -0,0 +1,187 @@
+#include <cstdio>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Threading/SpscQueue.h"
+#include "Threading/MpscQueue.h"
+#include "Threading/TripleBuffer.h"
+#include "Simulation/Match.h"
+#include "Benchmarks.h"
+
+static const uint32_t NumQueueItems = 4000000;
+
+static void BenchmarkSpsc()
+{
+    SpscQueue<uint32_t, 1024>* pQueue = new SpscQueue<uint32_t, 1024>();
+
+    BenchmarkTimer timer;
+    std::thread producer([pQueue]()
+    {
+        for (uint32_t i = 0; i < NumQueueItems; ++i)
+        {
+            while (!pQueue->TryPush(i))
+                std::this_thread::yield();
+        }
+    });
+
+    // Items from a single producer must come out in order
+    bool ordered = true;
+    uint32_t expected = 0;
+    while (expected < NumQueueItems)
+    {
+        uint32_t item;
+        if (pQueue->TryPop(item))
+            ordered &= (item == expected++);
+        else
+            std::this_thread::yield();
+    }
+
+    producer.join();
+    double seconds = timer.GetElapsedSeconds();
+
+    printf("spsc, 1 producer:  %6.1f M items/s%s\n", NumQueueItems / seconds / 1e6, ordered ? "" : " OUT OF ORDER");
+    delete pQueue;
+}
+
+static void BenchmarkMpsc(uint32_t numProducers)
+{
+    MpscQueue<uint32_t, 1024>* pQueue = new MpscQueue<uint32_t, 1024>();
+    uint32_t itemsPerProducer = NumQueueItems / numProducers;
+
+    BenchmarkTimer timer;
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < numProducers; ++p)
+    {
+        producers.emplace_back([pQueue, p, itemsPerProducer]()
+        {
+            for (uint32_t i = 0; i < itemsPerProducer; ++i)
+            {
+                while (!pQueue->TryPush(p))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<uint32_t> received(numProducers, 0);
+    for (uint32_t numReceived = 0; numReceived < itemsPerProducer * numProducers; )
+    {
+        uint32_t item;
+        if (pQueue->TryPop(item))
+        {
+            ++received[item];
+            ++numReceived;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+    double seconds = timer.GetElapsedSeconds();
+
+    bool complete = true;
+    for (uint32_t count : received)
+        complete &= (count == itemsPerProducer);
+
+    printf("mpsc, %u producers: %6.1f M items/s%s\n", numProducers, itemsPerProducer * numProducers / seconds / 1e6,
+        complete ? "" : " LOST ITEMS");
+    delete pQueue;
+}
+
+// A writer publishing as fast as it can while the reader keeps picking up the newest value
+static void BenchmarkTripleBuffer()
+{
+    struct Value
+    {
+        uint64_t sequence;
+        uint64_t check;             // Always derived from sequence; a torn read would break that
+    };
+
+    TripleBuffer<Value>* pBuffer = new TripleBuffer<Value>();
+    std::atomic<bool> stop(false);
+
+    BenchmarkTimer timer;
+    std::thread writer([pBuffer, &stop]()
+    {
+        for (uint64_t sequence = 1; !stop.load(std::memory_order_relaxed); ++sequence)
+        {
+            Value& value = pBuffer->GetWriteBuffer();
+            value.sequence = sequence;
+            value.check = ~sequence;
+            pBuffer->Publish();
+        }
+    });
+
+    bool consistent = true;
+    uint64_t numReads = 0;
+    uint64_t lastSequence = 0;
+    while (lastSequence < NumQueueItems)
+    {
+        if (!pBuffer->Update())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const Value& value = pBuffer->GetReadBuffer();
+        consistent &= (value.check == ~value.sequence && value.sequence > lastSequence);
+        lastSequence = value.sequence;
+        ++numReads;
+    }
+
+    stop = true;
+    writer.join();
+    double seconds = timer.GetElapsedSeconds();
+
+    printf("triple buffer:     %6.1f M publishes/s, %.1f%% read%s\n", lastSequence / seconds / 1e6,
+        100.0 * numReads / lastSequence, consistent ? "" : " INCONSISTENT");
+    delete pBuffer;
+}
+
+// Cost of publishing events from Match::Step(), with the queue drained after every step like the game does
+static void BenchmarkMatchEvents()
+{
+    const int numSteps = 2000000;
+    const Real deltaTime = Real(1.0f / 120.0f);
+
+    GameEventQueue* pQueue = new GameEventQueue();
+
+    for (int withQueue = 0; withQueue < 2; ++withQueue)
+    {
+        Match match;
+        match.SetEventQueue(withQueue ? pQueue : nullptr);
+
+        size_t numEvents = 0;
+        BenchmarkTimer timer;
+        for (int i = 0; i < numSteps; ++i)
+        {
+            MatchInput input;
+            input.paddles[0] = ChaseBallAction(match, 0);
+            input.paddles[1] = ChaseBallAction(match, 1);
+            input.start = true;
+            match.Step(input, deltaTime);
+
+            GameEvent event;
+            while (pQueue->TryPop(event))
+                ++numEvents;
+        }
+        double seconds = timer.GetElapsedSeconds();
+
+        printf("match step, %-8s %6.1f ns/step, %zu events\n", withQueue ? "events:" : "no queue:", seconds / numSteps * 1e9, numEvents);
+    }
+
+    delete pQueue;
+}
+
+void RunEventQueueBenchmark()
+{
+    BenchmarkSpsc();
+    BenchmarkMpsc(1);
+    BenchmarkMpsc(2);
+    BenchmarkMpsc(4);
+    BenchmarkTripleBuffer();
+    BenchmarkMatchEvents();
+}
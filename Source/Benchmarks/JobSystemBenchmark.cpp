@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Simulation/MatchBatch.h"
+#include "Threading/JobSystem.h"
+#include "Benchmarks.h"
+
+static const size_t NumBatchMatches = 65536;
+static const int NumBatchSteps = 200;
+
+// The AI on both sides: chase the ball
+static void ComputeInputs(const MatchBatch& batch, MatchInput* inputs, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        Real ballY = batch.GetBallPos(i).y;
+        for (size_t p = 0; p < Match::NumPaddles; ++p)
+        {
+            Real paddleY = batch.GetPaddlePos(i, p).y;
+            inputs[i].paddles[p] = (ballY > paddleY) ? PaddleAction::Up : (ballY < paddleY) ? PaddleAction::Down : PaddleAction::None;
+        }
+        inputs[i].start = true;
+    }
+}
+
+// Steps a batch of matches and returns a checksum over all of them. Without a job system everything runs on the calling thread.
+static uint32_t StepBatch(MatchBatch& batch, JobSystem* pJobs, double& outSeconds)
+{
+    const Real deltaTime = Real(1.0f / 120.0f);
+    std::vector<MatchInput> inputs(batch.GetCount());
+    MatchInput* pInputs = inputs.data();
+
+    BenchmarkTimer timer;
+    for (int step = 0; step < NumBatchSteps; ++step)
+    {
+        if (pJobs != nullptr)
+        {
+            pJobs->ParallelFor(batch.GetCount(), 1024, [&batch, pInputs](size_t begin, size_t end) { ComputeInputs(batch, pInputs, begin, end); });
+            batch.StepAll(pInputs, deltaTime, *pJobs);
+        }
+        else
+        {
+            ComputeInputs(batch, pInputs, 0, batch.GetCount());
+            batch.StepAll(pInputs, deltaTime);
+        }
+    }
+    outSeconds = timer.GetElapsedSeconds();
+
+    uint32_t checksum = 0;
+    for (size_t i = 0; i < batch.GetCount(); ++i)
+        checksum = checksum * 31 + batch.ComputeChecksum(i);
+
+    return checksum;
+}
+
+// Match steps per second with 1, 2, 4, ... threads. Efficiency is the speedup over the single threaded
+// run divided by the number of threads.
+void RunJobSystemBenchmark()
+{
+    double serialSeconds;
+    MatchBatch serialBatch(NumBatchMatches);
+    uint32_t serialChecksum = StepBatch(serialBatch, nullptr, serialSeconds);
+
+    double serialRate = NumBatchMatches * (double)NumBatchSteps / serialSeconds;
+    printf("  1 thread:  %8.1f M match steps/s\n", serialRate / 1e6);
+
+    unsigned int maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (unsigned int numThreads = 2; numThreads < maxThreads * 2; numThreads *= 2)
+    {
+        numThreads = std::min(numThreads, maxThreads);
+
+        JobSystem jobs(numThreads - 1);
+
+        double seconds;
+        MatchBatch batch(NumBatchMatches);
+        uint32_t checksum = StepBatch(batch, &jobs, seconds);
+
+        double rate = NumBatchMatches * (double)NumBatchSteps / seconds;
+        printf("%3u threads: %8.1f M match steps/s, %5.1f%% efficiency%s\n", numThreads, rate / 1e6,
+            100.0 * rate / serialRate / numThreads, (checksum == serialChecksum) ? "" : " MISMATCH");
+    }
+
+    // Scheduling overhead: many tiny jobs with dependencies
+    JobSystem jobs;
+    const int numJobs = 100000;
+    std::atomic<int> numRun(0);
+
+    BenchmarkTimer timer;
+    JobCounter first;
+    JobCounter second;
+    for (int i = 0; i < numJobs; ++i)
+        jobs.Run([&numRun]() { numRun.fetch_add(1, std::memory_order_relaxed); }, &first);
+    for (int i = 0; i < numJobs; ++i)
+        jobs.RunAfter(first, [&numRun]() { numRun.fetch_add(1, std::memory_order_relaxed); }, &second);
+    jobs.Wait(second);
+    double seconds = timer.GetElapsedSeconds();
+
+    printf("empty jobs on %zu threads: %.2f us per job (%d/%d run)\n", jobs.GetNumThreads(), seconds / (numJobs * 2) * 1e6, numRun.load(), numJobs * 2);
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <cstring>
+#include "Benchmarks.h"
+
+struct Benchmark
+{
+    const char* name;
+    void (*pRun)();
+};
+
+static const Benchmark s_benchmarks[] =
+{
+    { "collision", RunCollisionBenchmark },
+    { "batch",     RunMatchBatchBenchmark },
+    { "replay",    RunReplayBenchmark },
+    { "archive",   RunArchiveBenchmark },
+    { "events",    RunEventQueueBenchmark },
+    { "jobs",      RunJobSystemBenchmark },
+    { "ai",        RunPaddleAIBenchmark },
+    { "env",       RunVectorEnvironmentBenchmark },
+    { "render",    RunRenderBenchmark },
+    { "text",      RunTextLayoutBenchmark },
+    { "softrender", RunSoftwareRenderBenchmark },
+    { "shaders",   RunShaderCacheBenchmark },
+    { "assets",    RunAssetPackBenchmark },
+    { "loading",   RunAssetLoaderBenchmark },
+    { "wav",       RunWaveFileBenchmark },
+};
+
+int main(int argc, char** argv)
+{
+    int numRun = 0;
+
+    for (const Benchmark& benchmark : s_benchmarks)
+    {
+        bool selected = (argc < 2);
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strcmp(argv[i], benchmark.name) == 0)
+                selected = true;
+        }
+
+        if (!selected)
+            continue;
+
+        printf("== %s ==\n", benchmark.name);
+        benchmark.pRun();
+        printf("\n");
+
+        ++numRun;
+    }
+
+    if (numRun == 0)
+    {
+        printf("Usage: Benchmarks [name...]\nAvailable benchmarks:");
+        for (const Benchmark& benchmark : s_benchmarks)
+            printf(" %s", benchmark.name);
+        printf("\n");
+
+        return 1;
+    }
+
+    return 0;
+}
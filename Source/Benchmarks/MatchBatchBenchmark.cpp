@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Simulation/Match.h"
+#include "Simulation/MatchBatch.h"
+#include "Benchmarks.h"
+
+static const size_t NumCheckedMatches = 256;
+static const int NumCheckedSteps = 4000;
+static const size_t NumTimedMatches = 4096;
+static const int NumTimedSteps = 500;
+
+// Both paddles chase the ball, but every match gets its own mistakes, so rallies end and matches are won
+static void MakeInputs(const MatchBatch& batch, std::mt19937& rng, std::vector<MatchInput>& outInputs)
+{
+    std::uniform_int_distribution<int> mistake(0, 7);
+    for (size_t i = 0; i < batch.GetCount(); ++i)
+    {
+        Real ballY = batch.GetBallPos(i).y;
+        for (size_t p = 0; p < Match::NumPaddles; ++p)
+        {
+            Real paddleY = batch.GetPaddlePos(i, p).y;
+            PaddleAction action = (ballY > paddleY) ? PaddleAction::Up : (ballY < paddleY) ? PaddleAction::Down : PaddleAction::None;
+            outInputs[i].paddles[p] = (mistake(rng) == 0) ? PaddleAction::None : action;
+        }
+        outInputs[i].start = (mistake(rng) != 0);
+    }
+}
+
+// Steps Matches and a MatchBatch side by side and compares their checksums before the first step and
+// after every step. Returns the number of steps on which any match differed.
+static int CompareWithMatch(const MatchRules& rules, int& outNumOver)
+{
+    const Real deltaTime = Real(1.0f / 60.0f);
+
+    std::vector<Match> matches(NumCheckedMatches, Match(rules));
+    MatchBatch batch(NumCheckedMatches, rules);
+    std::vector<MatchInput> inputs(NumCheckedMatches);
+    std::mt19937 rng(99);
+
+    int numMismatches = 0;
+    for (int step = 0; step <= NumCheckedSteps; ++step)
+    {
+        bool same = true;
+        for (size_t i = 0; i < NumCheckedMatches; ++i)
+            same &= (matches[i].ComputeChecksum() == batch.ComputeChecksum(i));
+        numMismatches += same ? 0 : 1;
+
+        if (step == NumCheckedSteps)
+            break;
+
+        MakeInputs(batch, rng, inputs);
+        for (size_t i = 0; i < NumCheckedMatches; ++i)
+            matches[i].Step(inputs[i], deltaTime);
+        batch.StepAll(inputs.data(), deltaTime);
+    }
+
+    outNumOver = (int)batch.CountOver();
+
+    return numMismatches;
+}
+
+void RunMatchBatchBenchmark()
+{
+    for (int mode = 0; mode < 2; ++mode)
+    {
+        MatchRules rules;
+        rules.continuousCollision = (mode == 1);
+
+        int numOver = 0;
+        int numMismatches = CompareWithMatch(rules, numOver);
+        printf("%-10s %zu matches x %d steps (%d over): %s\n", rules.continuousCollision ? "continuous" : "discrete",
+            NumCheckedMatches, NumCheckedSteps, numOver,
+            (numMismatches == 0) ? "identical to Match after every step" : "MISMATCH");
+    }
+
+    // Throughput of the two, on the same inputs
+    const Real deltaTime = Real(1.0f / 120.0f);
+    MatchRules rules;
+    std::vector<Match> matches(NumTimedMatches, Match(rules));
+    MatchBatch batch(NumTimedMatches, rules);
+    std::vector<MatchInput> inputs(NumTimedMatches);
+    std::mt19937 rng(5);
+
+    double matchSeconds = 0.0;
+    double batchSeconds = 0.0;
+    for (int step = 0; step < NumTimedSteps; ++step)
+    {
+        MakeInputs(batch, rng, inputs);
+
+        BenchmarkTimer matchTimer;
+        for (size_t i = 0; i < NumTimedMatches; ++i)
+            matches[i].Step(inputs[i], deltaTime);
+        matchSeconds += matchTimer.GetElapsedSeconds();
+
+        BenchmarkTimer batchTimer;
+        batch.StepAll(inputs.data(), deltaTime);
+        batchSeconds += batchTimer.GetElapsedSeconds();
+    }
+
+    double numSteps = (double)NumTimedMatches * NumTimedSteps;
+    printf("Match:      %7.1f M match steps/s\n", numSteps / matchSeconds / 1e6);
+    printf("MatchBatch: %7.1f M match steps/s (%.1fx)\n", numSteps / batchSeconds / 1e6, matchSeconds / batchSeconds);
+}
@@ -0,0 +1,96 @@
+#include <cstdio>
+#include <cstdint>
+#include "AI/PaddleAI.h"
+#include "Benchmarks.h"
+
+static const int NumAIMatches = 200;
+static const int MaxAISteps = 120 * 60;
+
+struct AIMatchResults
+{
+    int         returns;            // Balls paddle 1 hit back
+    int         misses;             // Balls paddle 1 let through
+    uint64_t    steps;
+    uint64_t    actionChanges;      // Of paddle 1, a measure of jitter
+    double      seconds;
+};
+
+// Paddle 0 is the original chase AI, paddle 1 is the PaddleAI (or also the chase AI if pDifficulty is null).
+// Every match is played for a minute, or until it is over.
+static AIMatchResults PlayMatches(const PaddleAIDifficulty* pDifficulty)
+{
+    const Real deltaTime = Real(1.0f / 120.0f);
+
+    AIMatchResults results = {};
+    BenchmarkTimer timer;
+    for (int m = 0; m < NumAIMatches; ++m)
+    {
+        // Vary the serve so that the matches differ
+        MatchRules rules;
+        rules.ballServeVelocity.y = Real(150.0f + (float)(m % 20) * 15.0f);
+
+        Match match(rules);
+        PaddleAI ai(1, (pDifficulty != nullptr) ? *pDifficulty : PaddleAIDifficulty::Medium(), m + 1);
+
+        PaddleAction lastAction = PaddleAction::None;
+        for (int step = 0; step < MaxAISteps && !match.IsOver(); ++step)
+        {
+            MatchInput input;
+            input.paddles[0] = ChaseBallAction(match, 0);
+            input.paddles[1] = (pDifficulty != nullptr) ? ai.Decide(match, deltaTime) : ChaseBallAction(match, 1);
+            input.start = true;
+
+            results.actionChanges += (input.paddles[1] != lastAction) ? 1 : 0;
+            lastAction = input.paddles[1];
+
+            int paddleScore1 = match.GetPaddleScore1();
+            match.Step(input, deltaTime);
+            ++results.steps;
+
+            if ((match.GetEvents() & MatchEvent_PaddleHit) && match.GetBall().pos.x > match.GetWorldBounds().x * 0.5f)
+                ++results.returns;
+            if (match.GetPaddleScore1() != paddleScore1)
+                ++results.misses;
+        }
+    }
+    results.seconds = timer.GetElapsedSeconds();
+
+    return results;
+}
+
+static void PrintResults(const char* name, const AIMatchResults& results)
+{
+    printf("%-8s vs chase: missed %4d of %5d balls (%4.1f%%), %5.1f action changes/s, %5.1f ns/step\n", name,
+        results.misses, results.returns + results.misses, 100.0 * results.misses / (results.returns + results.misses),
+        results.actionChanges / (results.steps / 120.0), results.seconds / results.steps * 1e9);
+}
+
+void RunPaddleAIBenchmark()
+{
+    PrintResults("chase", PlayMatches(nullptr));
+
+    const struct { const char* name; PaddleAIDifficulty difficulty; } levels[] =
+    {
+        { "easy",    PaddleAIDifficulty::Easy() },
+        { "medium",  PaddleAIDifficulty::Medium() },
+        { "hard",    PaddleAIDifficulty::Hard() },
+        { "perfect", PaddleAIDifficulty::Perfect() },
+    };
+
+    for (const auto& level : levels)
+        PrintResults(level.name, PlayMatches(&level.difficulty));
+
+    // The prediction alone, with many bounces on the way
+    const int numPredictions = 10000000;
+    float sum = 0.0f;
+    BenchmarkTimer timer;
+    for (int i = 0; i < numPredictions; ++i)
+    {
+        Real y, time;
+        if (PredictBallY(320.0f, 240.0f, -350.0f, 300.0f + (float)(i & 1023), -600.0f, 5.0f, 475.0f, y, time))
+            sum += ToFloat(y);
+    }
+    double seconds = timer.GetElapsedSeconds();
+
+    printf("PredictBallY: %.1f ns/prediction (checksum %.0f)\n", seconds / numPredictions * 1e9, sum);
+}
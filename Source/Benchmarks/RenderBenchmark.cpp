@@ -0,0 +1,465 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include "Render/Renderer.h"
+#include "Render/NullRenderBackend.h"
+#include "Render/SoftwareRenderBackend.h"
+#include "Threading/JobSystem.h"
+#include "Benchmarks.h"
+
+static const int NumRenderFrames = 200000;
+static const int NumQuadsPerFrame = 100000;
+static const int NumQuadFrames = 100;
+static const int NumHudLines = 30;
+static const int NumTextFrames = 2000;
+static const int NumLayoutFrames = 20000;
+static const int NumSoftwareFrames = 2000;
+static const int NumFontLoads = 2000;
+
+static const char* FontBenchmarkFilename = "FontBenchmark.tmp";
+
+// Printable ASCII and the four arrows (U+2190 - U+2193) with plausible metrics, in place of the game's atlas
+static std::vector<Glyph> MakeBenchmarkGlyphs()
+{
+    std::vector<Glyph> glyphs;
+    glyphs.push_back({ 32, 0.3f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+
+    for (uint32_t cell = 0; cell < 98; ++cell)
+    {
+        uint32_t c = (cell < 94) ? 33 + cell : 0x2190 + cell - 94;
+        float x = (float)(cell % 10) * 48.0f;
+        float y = (float)(cell / 10) * 48.0f;
+        glyphs.push_back({ c, 0.6f, 0.05f, -0.1f, 0.55f, 0.75f, x, y, x + 40.0f, y + 44.0f });
+    }
+
+    return glyphs;
+}
+
+static FontAtlasBuilder MakeBenchmarkFontBuilder()
+{
+    FontAtlasBuilder builder(48, 512, 512);
+    for (const Glyph& glyph : MakeBenchmarkGlyphs())
+        builder.AddGlyph(glyph);
+
+    return builder;
+}
+
+static FontAtlas MakeBenchmarkFontAtlas()
+{
+    FontAtlas atlas;
+    atlas.Load(MakeBenchmarkFontBuilder().Bake());
+
+    return atlas;
+}
+
+// Every glyph cell of MakeBenchmarkFontAtlas() gets a blocky shape, so the text pass has something to sample
+static std::vector<uint8_t> MakeBenchmarkFontTexels()
+{
+    std::vector<uint8_t> texels(512 * 512);
+    for (uint32_t y = 0; y < 512; ++y)
+    {
+        for (uint32_t x = 0; x < 512; ++x)
+        {
+            uint32_t cellX = x % 48;
+            uint32_t cellY = y % 48;
+            bool inside = cellX < 40 && cellY < 44 && ((cellX / 8) + (cellY / 8) + (x / 48) * 3 + (y / 48)) % 3 != 0;
+            texels[y * 512 + x] = inside ? 255 : 0;
+        }
+    }
+
+    return texels;
+}
+
+struct GameFrameText
+{
+    TextRun     scores[2];
+    TextRun     prompt;
+};
+
+// The same calls as GameApp::Render() for a match waiting for players, where someone scores every few seconds
+static void RenderGameFrame(Renderer& renderer, GameFrameText& text, int frame)
+{
+    renderer.PreRender();
+
+    renderer.PrepareQuadPass();
+    renderer.RenderQuad(Float2(10.0f, 240.0f + (float)(frame % 100)), Float2(10.0f, 60.0f));
+    renderer.RenderQuad(Float2(630.0f, 240.0f - (float)(frame % 100)), Float2(10.0f, 60.0f));
+    renderer.RenderQuad(Float2(320.0f + (float)(frame % 300), 240.0f), Float2(10.0f, 10.0f));
+
+    renderer.PrepareTextPass();
+    renderer.UpdateTextRun(text.scores[0], std::to_string(frame / 500 % 10).c_str(), Float2(192.0f, 384.0f), 48.0f);
+    renderer.RenderTextRun(text.scores[0]);
+    renderer.UpdateTextRun(text.scores[1], std::to_string(frame / 700 % 10).c_str(), Float2(384.0f, 384.0f), 48.0f);
+    renderer.RenderTextRun(text.scores[1]);
+    renderer.UpdateTextRun(text.prompt, "Press SPACE to start", Float2(128.0f, 288.0f), 12.0f);
+    renderer.RenderTextRun(text.prompt);
+
+    renderer.PostRender();
+}
+
+static void PrintQuadFrames(const char* name, const NullRenderBackend& backend, double seconds)
+{
+    const RenderStats& frame = backend.GetFrameStats();
+    printf("%s: %6.1f ns/quad, %6u draws, %6u uploads, %8llu bytes uploaded per frame\n", name,
+        seconds / ((double)NumQuadFrames * NumQuadsPerFrame) * 1e9, frame.draws, frame.uploads, (unsigned long long)frame.bytesUploaded);
+}
+
+// A frame of many small quads (particles, say), drawn one draw and upload at a time as the Renderer
+// used to, and batched into one instanced draw. The null backend only shows the submission side; on a
+// GPU every draw and upload also costs a trip through the driver.
+static void RunQuadBatchBenchmark()
+{
+    std::vector<QuadInstance> quads(NumQuadsPerFrame);
+    for (int i = 0; i < NumQuadsPerFrame; ++i)
+        quads[i] = { Float2((float)(i % 640), (float)(i / 640 % 480)), Float2(2.0f, 2.0f) };
+
+    NullRenderBackend backend;
+    Renderer renderer;
+    renderer.Initialize(&backend);
+
+    BenchmarkTimer timer;
+    for (int frame = 0; frame < NumQuadFrames; ++frame)
+    {
+        backend.BeginFrame(Float4x4::Identity(), Float4x4::Identity());
+        backend.SetPass(RenderPass::Quads);
+        for (const QuadInstance& quad : quads)
+            backend.DrawQuadInstances(&quad, 1);
+        backend.EndFrame();
+    }
+    PrintQuadFrames("100k quads, one draw each  ", backend, timer.GetElapsedSeconds());
+
+    timer = BenchmarkTimer();
+    for (int frame = 0; frame < NumQuadFrames; ++frame)
+    {
+        renderer.PreRender();
+        renderer.PrepareQuadPass();
+        for (const QuadInstance& quad : quads)
+            renderer.RenderQuad(quad.pos, quad.scale);
+        renderer.PostRender();
+    }
+    PrintQuadFrames("100k quads, RenderQuad()   ", backend, timer.GetElapsedSeconds());
+
+    timer = BenchmarkTimer();
+    for (int frame = 0; frame < NumQuadFrames; ++frame)
+    {
+        renderer.PreRender();
+        renderer.PrepareQuadPass();
+        renderer.RenderQuads(quads.data(), quads.size());
+        renderer.PostRender();
+    }
+    PrintQuadFrames("100k quads, RenderQuads()  ", backend, timer.GetElapsedSeconds());
+
+    renderer.Uninitialize();
+}
+
+// What Renderer::RenderText() did before glyphs were batched: an upload and a draw per glyph
+static void RenderTextPerGlyph(RenderBackend& backend, const FontAtlas& atlas, const std::string& str, const Float2& pos, float size)
+{
+    float offset = pos.x;
+    for (char c : str)
+    {
+        const GlyphQuad* pGlyph = atlas.FindGlyph((uint8_t)c);
+        if (pGlyph == nullptr)
+            continue;
+
+        float left = pGlyph->planeLeft * size + offset;
+        float right = pGlyph->planeRight * size + offset;
+        float top = pGlyph->planeTop * size + pos.y;
+        float bottom = pGlyph->planeBottom * size + pos.y;
+
+        TextVertex verts[4] =
+        {
+            { Float3(right, top,    0.0f), Float2(pGlyph->u1, pGlyph->v0) },
+            { Float3(left,  top,    0.0f), Float2(pGlyph->u0, pGlyph->v0) },
+            { Float3(right, bottom, 0.0f), Float2(pGlyph->u1, pGlyph->v1) },
+            { Float3(left,  bottom, 0.0f), Float2(pGlyph->u0, pGlyph->v1) },
+        };
+        backend.DrawTextQuads(verts, 1);
+
+        offset += pGlyph->advance * size;
+    }
+}
+
+// A HUD's worth of text, drawn a glyph at a time and batched into one draw per text pass
+static void RunTextBatchBenchmark()
+{
+    std::vector<std::string> lines;
+    for (int i = 0; i < NumHudLines; ++i)
+        lines.push_back("Player " + std::to_string(i) + ": 12 points, 345 hits, rally 67");
+
+    NullRenderBackend backend;
+    Renderer renderer;
+    renderer.Initialize(&backend);
+    renderer.SetFontAtlas(MakeBenchmarkFontAtlas());
+
+    BenchmarkTimer timer;
+    for (int frame = 0; frame < NumTextFrames; ++frame)
+    {
+        backend.BeginFrame(Float4x4::Identity(), Float4x4::Identity());
+        backend.SetPass(RenderPass::Text);
+        for (int i = 0; i < NumHudLines; ++i)
+            RenderTextPerGlyph(backend, renderer.GetFontAtlas(), lines[i], Float2(8.0f, 470.0f - 15.0f * i), 12.0f);
+        backend.EndFrame();
+    }
+    double perGlyphSeconds = timer.GetElapsedSeconds();
+    RenderStats perGlyph = backend.GetFrameStats();
+
+    for (int frame = 0; frame < NumTextFrames; ++frame)
+    {
+        renderer.PreRender();
+        renderer.PrepareTextPass();
+        for (int i = 0; i < NumHudLines; ++i)
+            renderer.RenderText(lines[i], Float2(8.0f, 470.0f - 15.0f * i), 12.0f);
+        renderer.PostRender();
+    }
+    RenderTimings batched = renderer.GetTimings();
+    RenderStats batchedStats = backend.GetFrameStats();
+
+    // The HUD doesn't change, so after the first frame the runs are only copied into the batch
+    std::vector<TextRun> runs(NumHudLines);
+    renderer.ResetTimings();
+    for (int frame = 0; frame < NumTextFrames; ++frame)
+    {
+        renderer.PreRender();
+        renderer.PrepareTextPass();
+        for (int i = 0; i < NumHudLines; ++i)
+        {
+            renderer.UpdateTextRun(runs[i], lines[i].c_str(), Float2(8.0f, 470.0f - 15.0f * i), 12.0f);
+            renderer.RenderTextRun(runs[i]);
+        }
+        renderer.PostRender();
+    }
+    const RenderTimings& retained = renderer.GetTimings();
+
+    printf("HUD, %u glyphs, one draw each: %6.2f us/frame, %4u draws, %4u uploads\n", perGlyph.primitives / 2,
+        perGlyphSeconds / NumTextFrames * 1e6, perGlyph.draws, perGlyph.uploads);
+    printf("HUD, %u glyphs, batched:       %6.2f us/frame, %4u draws, %4u uploads\n", batchedStats.primitives / 2,
+        batched.totalSubmitSeconds / batched.frames * 1e6, batchedStats.draws, batchedStats.uploads);
+    printf("HUD, %u glyphs, text runs:     %6.2f us/frame, %4u layouts in %d frames\n", backend.GetFrameStats().primitives / 2,
+        retained.totalSubmitSeconds / retained.frames * 1e6, runs[0].GetNumLayouts() * NumHudLines, NumTextFrames);
+
+    renderer.Uninitialize();
+}
+
+void RunRenderBenchmark()
+{
+    NullRenderBackend backend;
+    Renderer renderer;
+    renderer.Initialize(&backend);
+    renderer.SetFontAtlas(MakeBenchmarkFontAtlas());
+
+    GameFrameText text;
+
+    // One frame recorded, to show the command stream's shape
+    backend.SetRecording(true);
+    RenderGameFrame(renderer, text, 0);
+    backend.SetRecording(false);
+
+    const std::vector<RenderCommand>& commands = backend.GetCommands();
+    const RenderStats& frame = backend.GetFrameStats();
+    printf("Frame: %zu commands, %u draws, %u triangles, %u state changes, %u uploads, %llu bytes uploaded\n", commands.size(),
+        frame.draws, frame.primitives, frame.stateChanges, frame.uploads, (unsigned long long)frame.bytesUploaded);
+    backend.ClearCommands();
+
+    // Timed by the renderer itself
+    renderer.ResetTimings();
+    for (int i = 0; i < NumRenderFrames; ++i)
+        RenderGameFrame(renderer, text, i);
+
+    const RenderTimings& timings = renderer.GetTimings();
+    const RenderStats& total = backend.GetTotalStats();
+    double frames = (double)backend.GetNumFrames();
+    printf("%d frames: %.2f us/frame (%.2f us at most), %.1f draws/frame, %.0f bytes/frame, %u text layouts\n", NumRenderFrames,
+        timings.totalFrameSeconds / timings.frames * 1e6, timings.maxFrameSeconds * 1e6, total.draws / frames,
+        total.bytesUploaded / frames, text.scores[0].GetNumLayouts() + text.scores[1].GetNumLayouts() + text.prompt.GetNumLayouts());
+
+    renderer.Uninitialize();
+
+    RunQuadBatchBenchmark();
+    RunTextBatchBenchmark();
+}
+
+// How glyphs were laid out before FontAtlas had a direct table: a hash lookup per character and the
+// texture coordinates divided out every time
+static size_t LayoutTextHashed(const std::unordered_map<uint32_t, Glyph>& glyphs, uint32_t width, uint32_t height,
+    const std::string& str, const Float2& pos, float size, std::vector<TextVertex>& outVertices)
+{
+    size_t numGlyphs = 0;
+    float offset = pos.x;
+    for (char c : str)
+    {
+        auto findIt = glyphs.find((uint32_t)c);
+        if (findIt == glyphs.end())
+            continue;
+
+        const Glyph& glyph = findIt->second;
+        float u0 = glyph.atlasLeft / (float)width;
+        float u1 = glyph.atlasRight / (float)width;
+        float v0 = 1.0f - glyph.atlasTop / (float)height;
+        float v1 = 1.0f - glyph.atlasBottom / (float)height;
+        float left = glyph.planeLeft * size + offset;
+        float right = glyph.planeRight * size + offset;
+        float top = glyph.planeTop * size + pos.y;
+        float bottom = glyph.planeBottom * size + pos.y;
+
+        outVertices.push_back({ Float3(right, top,    0.0f), Float2(u1, v0) });
+        outVertices.push_back({ Float3(left,  top,    0.0f), Float2(u0, v0) });
+        outVertices.push_back({ Float3(right, bottom, 0.0f), Float2(u1, v1) });
+        outVertices.push_back({ Float3(left,  bottom, 0.0f), Float2(u0, v1) });
+
+        offset += glyph.advance * size;
+        ++numGlyphs;
+    }
+
+    return numGlyphs;
+}
+
+// Lays out every line once per frame through the Renderer, returning glyphs per second
+static double LayoutTextFrames(Renderer& renderer, NullRenderBackend& backend, const std::vector<std::string>& lines)
+{
+    uint64_t numGlyphs = 0;
+
+    BenchmarkTimer timer;
+    for (int frame = 0; frame < NumLayoutFrames; ++frame)
+    {
+        renderer.PreRender();
+        renderer.PrepareTextPass();
+        for (size_t i = 0; i < lines.size(); ++i)
+            renderer.RenderText(lines[i], Float2(8.0f, 470.0f - 15.0f * i), 12.0f);
+        renderer.PostRender();
+
+        numGlyphs += backend.GetFrameStats().primitives / 2;
+    }
+
+    return numGlyphs / timer.GetElapsedSeconds();
+}
+
+void RunTextLayoutBenchmark()
+{
+    std::vector<std::string> asciiLines;
+    std::vector<std::string> arrowLines;
+    for (int i = 0; i < NumHudLines; ++i)
+    {
+        asciiLines.push_back("Player " + std::to_string(i) + ": 12 points, 345 hits, rally 67");
+
+        // With arrows (U+2191, U+2193, U+2190, U+2192) from outside Latin-1, in UTF-8
+        arrowLines.push_back("Move \xe2\x86\x91 and \xe2\x86\x93, serve \xe2\x86\x90 \xe2\x86\x92 to start #" + std::to_string(i));
+    }
+
+    std::vector<Glyph> glyphs = MakeBenchmarkGlyphs();
+    std::unordered_map<uint32_t, Glyph> glyphMap;
+    for (const Glyph& glyph : glyphs)
+        glyphMap[glyph.unicode] = glyph;
+
+    std::vector<TextVertex> vertices;
+    uint64_t numHashedGlyphs = 0;
+    BenchmarkTimer timer;
+    for (int frame = 0; frame < NumLayoutFrames; ++frame)
+    {
+        vertices.clear();
+        for (size_t i = 0; i < asciiLines.size(); ++i)
+            numHashedGlyphs += LayoutTextHashed(glyphMap, 512, 512, asciiLines[i], Float2(8.0f, 470.0f - 15.0f * i), 12.0f, vertices);
+    }
+    double hashedRate = numHashedGlyphs / timer.GetElapsedSeconds();
+
+    NullRenderBackend backend;
+    Renderer renderer;
+    renderer.Initialize(&backend);
+    renderer.SetFontAtlas(MakeBenchmarkFontAtlas());
+
+    double asciiRate = LayoutTextFrames(renderer, backend, asciiLines);
+    double arrowRate = LayoutTextFrames(renderer, backend, arrowLines);
+
+    renderer.Uninitialize();
+
+    printf("Hashed lookup, ASCII:        %6.1f M glyphs/s\n", hashedRate / 1e6);
+    printf("Direct table, ASCII:         %6.1f M glyphs/s (%.1fx)\n", asciiRate / 1e6, asciiRate / hashedRate);
+    printf("With sorted fallback, UTF-8: %6.1f M glyphs/s\n", arrowRate / 1e6);
+
+    // Loading the font: mapping the baked file, against adding every glyph as the JSON loader used to
+    bool ok = MakeBenchmarkFontBuilder().Write(FontBenchmarkFilename);
+    BenchmarkTimer openTimer;
+    for (int i = 0; i < NumFontLoads; ++i)
+    {
+        FontAtlas atlas;
+        ok &= atlas.Open(FontBenchmarkFilename) && atlas.FindGlyph('A') != nullptr && atlas.FindGlyph(0x2191) != nullptr;
+    }
+    double openSeconds = openTimer.GetElapsedSeconds() / NumFontLoads;
+    remove(FontBenchmarkFilename);
+
+    BenchmarkTimer buildTimer;
+    for (int i = 0; i < NumFontLoads; ++i)
+    {
+        FontAtlas atlas = MakeBenchmarkFontAtlas();
+        ok &= atlas.GetNumGlyphs() == glyphs.size();
+    }
+    double buildSeconds = buildTimer.GetElapsedSeconds() / NumFontLoads;
+
+    printf("Font load: baked file mapped in %.1f us, built from %zu glyphs in %.1f us%s\n", openSeconds * 1e6,
+        glyphs.size(), buildSeconds * 1e6, ok ? "" : " FAILED");
+}
+
+static uint32_t CountPixels(const SoftwareRenderBackend& backend, uint32_t color)
+{
+    uint32_t count = 0;
+    const uint32_t* pPixels = backend.GetPixels();
+    for (size_t i = 0; i < (size_t)backend.GetWidth() * (size_t)backend.GetHeight(); ++i)
+        count += (pPixels[i] == color) ? 1 : 0;
+
+    return count;
+}
+
+static double RenderSoftwareFrames(SoftwareRenderBackend& backend)
+{
+    std::vector<uint8_t> texels = MakeBenchmarkFontTexels();
+    backend.SetFontAtlasTexture(texels.data(), 512, 512, 1);
+
+    Renderer renderer;
+    renderer.Initialize(&backend);
+    renderer.SetFontAtlas(MakeBenchmarkFontAtlas());
+
+    GameFrameText text;
+
+    BenchmarkTimer timer;
+    for (int i = 0; i < NumSoftwareFrames; ++i)
+        RenderGameFrame(renderer, text, i);
+    double seconds = timer.GetElapsedSeconds();
+
+    // Leave the first frame in the framebuffer, for comparing backends
+    RenderGameFrame(renderer, text, 0);
+    renderer.Uninitialize();
+
+    return seconds;
+}
+
+void RunSoftwareRenderBenchmark()
+{
+    SoftwareRenderBackend serialBackend;
+    double serialSeconds = RenderSoftwareFrames(serialBackend);
+
+    JobSystem jobs;
+    SoftwareRenderBackend parallelBackend(640, 480, &jobs);
+    double parallelSeconds = RenderSoftwareFrames(parallelBackend);
+
+    bool identical = memcmp(serialBackend.GetPixels(), parallelBackend.GetPixels(), 640 * 480 * sizeof(uint32_t)) == 0;
+
+    // The paddles and the ball alone are pixel aligned: 2 * 10x60 + 10x10 white pixels
+    SoftwareRenderBackend quadBackend;
+    Renderer renderer;
+    renderer.Initialize(&quadBackend);
+    renderer.PreRender();
+    renderer.PrepareQuadPass();
+    renderer.RenderQuad(Float2(10.0f, 240.0f), Float2(10.0f, 60.0f));
+    renderer.RenderQuad(Float2(630.0f, 240.0f), Float2(10.0f, 60.0f));
+    renderer.RenderQuad(Float2(320.0f, 240.0f), Float2(10.0f, 10.0f));
+    renderer.PostRender();
+    renderer.Uninitialize();
+
+    printf("640x480, 1 thread:   %7.0f frames/s (%.1f us/frame)\n", NumSoftwareFrames / serialSeconds, serialSeconds / NumSoftwareFrames * 1e6);
+    printf("640x480, %zu threads: %7.0f frames/s (%.1f us/frame)\n", jobs.GetNumThreads(), NumSoftwareFrames / parallelSeconds,
+        parallelSeconds / NumSoftwareFrames * 1e6);
+    printf("Quads: %u white pixels (1300 expected); game frame: %u pixels drawn, serial and threaded frames %s\n",
+        CountPixels(quadBackend, SoftwareRenderBackend::QuadColor), 640 * 480 - CountPixels(serialBackend, SoftwareRenderBackend::ClearColor),
+        identical ? "match" : "DIFFER");
+}
@@ -0,0 +1,163 @@
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Replay/Replay.h"
+#include "Benchmarks.h"
+
+static const Real ReplayDeltaTime = Real(1.0f / 120.0f);
+static const uint32_t MaxReplayTicks = 120 * 60 * 10;
+
+std::vector<uint8_t> RecordBenchmarkMatch(uint32_t seed, uint32_t keyframeInterval)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> action(0, 2);
+    std::uniform_int_distribution<int> holdTicks(5, 40);
+
+    Match match;
+    ReplayWriter writer;
+    writer.Begin(match.GetRules(), ReplayDeltaTime, 0x1, keyframeInterval);
+
+    PaddleAction held = PaddleAction::None;
+    int holdRemaining = 0;
+
+    for (uint32_t tick = 0; tick < MaxReplayTicks && !match.IsOver(); ++tick)
+    {
+        if (holdRemaining-- <= 0)
+        {
+            held = (PaddleAction)action(rng);
+            holdRemaining = holdTicks(rng);
+        }
+
+        MatchInput input;
+        input.paddles[0] = held;
+        input.paddles[1] = ChaseBallAction(match, 1);
+        input.start = (match.GetState() == GameState::WaitingForPlayers);
+
+        writer.RecordTick(input, match);
+        match.Step(input, ReplayDeltaTime);
+    }
+
+    writer.End(match);
+    return writer.GetData();
+}
+
+// Records a one-tick replay whose keyframe holds the given snapshot. The match ends in a valid
+// state, so only the keyframe can make the replay unreadable.
+static std::vector<uint8_t> RecordSnapshotReplay(const MatchSnapshot& snapshot)
+{
+    Match match;
+    match.LoadSnapshot(snapshot);
+
+    ReplayWriter writer;
+    writer.Begin(match.GetRules(), ReplayDeltaTime);
+    writer.RecordTick(MatchInput(), match);
+    writer.End(Match());
+    return writer.GetData();
+}
+
+// Keyframes with a state or score no match can be in have to be rejected, not loaded
+static bool CheckDamagedKeyframes()
+{
+    Match match;
+    MatchSnapshot valid;
+    match.SaveSnapshot(valid);
+
+    const uint8_t badStates[] = { (uint8_t)GameState::Invalid, (uint8_t)GameState::Running + 1, 200 };
+    const int winningScore = match.GetRules().winningScore;
+
+    std::vector<MatchSnapshot> damaged;
+    for (uint8_t state : badStates)
+    {
+        damaged.push_back(valid);
+        damaged.back().state = (GameState)state;
+    }
+    damaged.push_back(valid);
+    damaged.back().paddleScore1 = winningScore + 1;
+    damaged.push_back(valid);
+    damaged.back().paddleScore2 = -1;
+
+    bool ok = true;
+    for (const MatchSnapshot& snapshot : damaged)
+    {
+        std::vector<uint8_t> replay = RecordSnapshotReplay(snapshot);
+        ReplayPlayer player;
+        ok &= !player.Open(replay.data(), replay.size());
+    }
+
+    std::vector<uint8_t> replay = RecordSnapshotReplay(valid);
+    ReplayPlayer player;
+    ok &= player.Open(replay.data(), replay.size());
+
+    return ok;
+}
+
+void RunReplayBenchmark()
+{
+    const int numMatches = 64;
+
+    std::vector<std::vector<uint8_t>> replays;
+    size_t totalBytes = 0;
+    uint64_t totalTicks = 0;
+
+    BenchmarkTimer recordTimer;
+    for (int i = 0; i < numMatches; ++i)
+    {
+        replays.push_back(RecordBenchmarkMatch(1000 + i, ReplayWriter::DefaultKeyframeInterval));
+        totalBytes += replays.back().size();
+
+        ReplayInfo info;
+        ReplayPlayer::ReadInfo(replays.back().data(), replays.back().size(), info);
+        totalTicks += info.numTicks;
+    }
+    double recordSeconds = recordTimer.GetElapsedSeconds();
+
+    printf("%d matches, %.0f ticks/match, %.0f bytes/match (%.3f bytes/tick), recorded in %.3f s\n",
+        numMatches, (double)totalTicks / numMatches, (double)totalBytes / numMatches,
+        (double)totalBytes / totalTicks, recordSeconds);
+
+    // Full playback with verification against the recorded checksum
+    int numVerified = 0;
+    BenchmarkTimer playTimer;
+    for (const std::vector<uint8_t>& replay : replays)
+    {
+        ReplayPlayer player;
+        if (player.Open(replay.data(), replay.size()) && player.Verify())
+            ++numVerified;
+    }
+    double playSeconds = playTimer.GetElapsedSeconds();
+
+    printf("playback: %.1f M ticks/s, %d/%d replays verified\n", totalTicks / playSeconds / 1e6, numVerified, numMatches);
+
+    // Random seeks, with keyframes and without
+    const uint32_t intervals[] = { ReplayWriter::DefaultKeyframeInterval, 0 };
+    for (uint32_t interval : intervals)
+    {
+        std::vector<uint8_t> replay = RecordBenchmarkMatch(1000, interval);
+
+        ReplayPlayer player;
+        player.Open(replay.data(), replay.size());
+
+        std::mt19937 rng(99);
+        std::uniform_int_distribution<uint32_t> tick(0, player.GetInfo().numTicks);
+
+        const int numSeeks = 200;
+        bool ok = true;
+
+        BenchmarkTimer seekTimer;
+        for (int i = 0; i < numSeeks; ++i)
+            ok &= player.Seek(tick(rng));
+        double seekSeconds = seekTimer.GetElapsedSeconds();
+
+        // Seeking must land on exactly the state a straight playback reaches
+        ReplayPlayer reference;
+        reference.Open(replay.data(), replay.size());
+        reference.Seek(player.GetTick());
+        ok &= (reference.GetMatch().ComputeChecksum() == player.GetMatch().ComputeChecksum());
+
+        printf("seek (keyframe interval %4u): %7.1f us/seek, %zu bytes%s\n",
+            interval, seekSeconds / numSeeks * 1e6, replay.size(), ok ? "" : " MISMATCH");
+    }
+
+    printf("damaged keyframes: %s\n", CheckDamagedKeyframes() ? "ok, rejected" : "FAILED");
+}
@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Platform/File.h"
+#include "Platform/MappedFile.h"
+#include "Render/ShaderCache.h"
+#include "Benchmarks.h"
+
+static const char* ShaderBenchmarkSourceFilename = "ShaderBenchmark.tmp";
+
+// What the renderer does for each shader at startup when the cache is warm: map the source, hash it and
+// read the bytecode from the cache file
+static bool LoadCachedShader(const char* entryPoint, std::vector<uint8_t>& outBytecode)
+{
+    MappedFile source;
+    if (!source.Open(ShaderBenchmarkSourceFilename))
+        return false;
+
+    uint64_t key = ComputeShaderKey(source.GetData(), source.GetSize(), entryPoint, "vs_4_0", 0);
+    std::string cacheFileName = GetShaderCacheFileName(ShaderBenchmarkSourceFilename, entryPoint);
+
+    return ReadShaderCache(cacheFileName.c_str(), key, outBytecode);
+}
+
+static bool WriteBenchmarkSource(const std::string& source)
+{
+    FILE* pFile = OpenStdioFile(ShaderBenchmarkSourceFilename, "wb");
+    if (pFile == nullptr)
+        return false;
+
+    bool ok = (fwrite(source.data(), 1, source.size(), pFile) == source.size());
+    return (fclose(pFile) == 0) && ok;
+}
+
+void RunShaderCacheBenchmark()
+{
+    // The D3D11 backend loads four shaders; the source and bytecode are about the size of the game's
+    const char* entryPoints[] = { "VSMain", "PSMain", "VSText", "PSText" };
+    const int numShaders = sizeof(entryPoints) / sizeof(entryPoints[0]);
+    const int numStartups = 2000;
+
+    std::string source;
+    for (int i = 0; source.size() < 2048; ++i)
+        source += "float4 Function" + std::to_string(i) + "(float4 v) { return v * " + std::to_string(i) + ".0f; }\n";
+
+    std::vector<uint8_t> bytecode(1500);
+    for (size_t i = 0; i < bytecode.size(); ++i)
+        bytecode[i] = (uint8_t)(i * 31 + 7);
+
+    bool ok = WriteBenchmarkSource(source);
+
+    // Filling the cache, as the build step does
+    BenchmarkTimer writeTimer;
+    for (const char* entryPoint : entryPoints)
+    {
+        uint64_t key = ComputeShaderKey(source.data(), source.size(), entryPoint, "vs_4_0", 0);
+        std::string cacheFileName = GetShaderCacheFileName(ShaderBenchmarkSourceFilename, entryPoint);
+        ok &= WriteShaderCache(cacheFileName.c_str(), key, bytecode.data(), bytecode.size());
+    }
+    double writeSeconds = writeTimer.GetElapsedSeconds();
+
+    BenchmarkTimer loadTimer;
+    std::vector<uint8_t> loaded;
+    int numHits = 0;
+    for (int startup = 0; startup < numStartups; ++startup)
+    {
+        for (const char* entryPoint : entryPoints)
+        {
+            if (LoadCachedShader(entryPoint, loaded) && loaded == bytecode)
+                ++numHits;
+        }
+    }
+    double loadSeconds = loadTimer.GetElapsedSeconds();
+    ok &= (numHits == numStartups * numShaders);
+
+    // An edited source must miss the cache, so the shader is compiled again
+    ok &= WriteBenchmarkSource(source + "// edited\n");
+    for (const char* entryPoint : entryPoints)
+        ok &= !LoadCachedShader(entryPoint, loaded);
+
+    printf("cache write: %d shaders in %.1f us\n", numShaders, writeSeconds * 1e6);
+    printf("startup from the cache: %.1f us for %d shaders (%.1f us per shader, %d startups)%s\n",
+        loadSeconds / numStartups * 1e6, numShaders, loadSeconds / (numStartups * numShaders) * 1e6, numStartups,
+        ok ? "" : " FAILED");
+
+    remove(ShaderBenchmarkSourceFilename);
+    for (const char* entryPoint : entryPoints)
+        remove(GetShaderCacheFileName(ShaderBenchmarkSourceFilename, entryPoint).c_str());
+}
@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "AI/VectorEnvironment.h"
+#include "Platform/AlignedAllocator.h"
+#include "Threading/JobSystem.h"
+#include "Benchmarks.h"
+
+static const size_t NumEnvironments = 4096;
+static const int NumEnvironmentSteps = 2000;
+
+struct EnvironmentResults
+{
+    double      seconds;
+    uint64_t    episodes;
+    double      reward;
+    uint32_t    checksum;           // Of every observation, to compare the runs
+};
+
+// A random agent, with its actions drawn up front so that only the environment is timed
+static EnvironmentResults RunEnvironments(const EnvironmentConfig& config, JobSystem* pJobs)
+{
+    VectorEnvironment environment(NumEnvironments, config, pJobs);
+
+    std::vector<uint32_t> seeds(NumEnvironments);
+    std::vector<PaddleAction> actions(NumEnvironments * 16);
+    uint32_t random = 12345;
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        random = random * 1664525u + 1013904223u;
+        actions[i] = (PaddleAction)((random >> 24) % 3);
+    }
+    for (size_t i = 0; i < NumEnvironments; ++i)
+        seeds[i] = (uint32_t)i;
+
+    // Cache line aligned, so that threads stepping neighbouring blocks don't share lines of the results
+    std::vector<float, AlignedAllocator<float, 64>> observations(NumEnvironments * VectorEnvironment::ObservationSize);
+    std::vector<float, AlignedAllocator<float, 64>> rewards(NumEnvironments);
+    std::vector<uint8_t, AlignedAllocator<uint8_t, 64>> dones(NumEnvironments);
+
+    environment.Reset(seeds.data(), observations.data());
+
+    EnvironmentResults results = {};
+    BenchmarkTimer timer;
+    for (int step = 0; step < NumEnvironmentSteps; ++step)
+    {
+        const PaddleAction* pActions = actions.data() + (step & 15) * NumEnvironments;
+        environment.Step(pActions, observations.data(), rewards.data(), dones.data());
+
+        for (size_t i = 0; i < NumEnvironments; ++i)
+        {
+            results.episodes += dones[i];
+            results.reward += rewards[i];
+        }
+
+        // Hash a few of the observations, like an agent reading them would
+        uint32_t bits;
+        memcpy(&bits, &observations[(step * 7919) % observations.size()], sizeof(bits));
+        results.checksum = results.checksum * 31 + bits;
+    }
+    results.seconds = timer.GetElapsedSeconds();
+
+    return results;
+}
+
+static void PrintResults(const char* name, const EnvironmentResults& results)
+{
+    double steps = (double)NumEnvironments * NumEnvironmentSteps;
+    printf("%-16s %6.2f M env steps/s, %6llu episodes, %+.3f reward/episode (checksum %08x)\n", name,
+        steps / results.seconds / 1e6, (unsigned long long)results.episodes,
+        results.episodes ? results.reward / results.episodes : 0.0, results.checksum);
+}
+
+void RunVectorEnvironmentBenchmark()
+{
+    // Large steps, so that random play finishes a good number of episodes
+    EnvironmentConfig config;
+    config.stepSeconds = 1.0f / 30.0f;
+    config.rules.continuousCollision = true;
+
+    JobSystem jobs;
+
+    EnvironmentResults serial = RunEnvironments(config, nullptr);
+    EnvironmentResults parallel = RunEnvironments(config, &jobs);
+
+    printf("%zu environments, %zu threads\n", NumEnvironments, jobs.GetNumThreads());
+    PrintResults("serial", serial);
+    PrintResults("job system", parallel);
+
+    config.agentPaddle = 1;
+    PrintResults("serial, right", RunEnvironments(config, nullptr));
+
+    config.agentPaddle = 0;
+    config.frameSkip = 4;
+    config.stepSeconds = 1.0f / 120.0f;
+    PrintResults("frame skip 4", RunEnvironments(config, &jobs));
+
+    printf("Serial and job system runs %s\n", (serial.checksum == parallel.checksum) ? "match" : "DIFFER");
+}
@@ -0,0 +1,205 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "Assets/WaveFile.h"
+#include "Benchmarks.h"
+
+static const int NumWaveParses = 20000;
+static const uint32_t NumWaveFrames = 8000;
+
+struct BenchmarkWaveFormat
+{
+    uint16_t    formatTag;              // 1 PCM, 3 float, 0xfffe extensible PCM
+    uint16_t    numChannels;
+    uint16_t    bitsPerSample;
+};
+
+static const BenchmarkWaveFormat s_waveFormats[] =
+{
+    { 1,        1,  8 },
+    { 1,        1,  16 },
+    { 1,        2,  16 },
+    { 1,        2,  24 },
+    { 1,        2,  32 },
+    { 3,        2,  32 },
+    { 3,        1,  64 },
+    { 0xfffe,   2,  24 },
+};
+
+static void Append16(std::vector<uint8_t>& data, uint16_t value)
+{
+    data.push_back((uint8_t)value);
+    data.push_back((uint8_t)(value >> 8));
+}
+
+static void Append32(std::vector<uint8_t>& data, uint32_t value)
+{
+    Append16(data, (uint16_t)value);
+    Append16(data, (uint16_t)(value >> 16));
+}
+
+static void AppendChunk(std::vector<uint8_t>& data, uint32_t id, const std::vector<uint8_t>& contents)
+{
+    Append32(data, id);
+    Append32(data, (uint32_t)contents.size());
+    data.insert(data.end(), contents.begin(), contents.end());
+    if (contents.size() & 1)
+        data.push_back(0);
+}
+
+// A WAV file as editors write them: the format, a LIST of INFO tags and an odd sized chunk before the samples
+static std::vector<uint8_t> MakeWave(const BenchmarkWaveFormat& format)
+{
+    uint16_t blockAlign = format.numChannels * (format.bitsPerSample / 8);
+
+    std::vector<uint8_t> fmt;
+    Append16(fmt, format.formatTag);
+    Append16(fmt, format.numChannels);
+    Append32(fmt, 44100);
+    Append32(fmt, 44100 * blockAlign);
+    Append16(fmt, blockAlign);
+    Append16(fmt, format.bitsPerSample);
+    if (format.formatTag == 0xfffe)
+    {
+        static const uint8_t subFormatPcm[16] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+        Append16(fmt, 22);
+        Append16(fmt, format.bitsPerSample);
+        Append32(fmt, 0x3);
+        fmt.insert(fmt.end(), subFormatPcm, subFormatPcm + sizeof(subFormatPcm));
+    }
+
+    std::vector<uint8_t> list = { 'I', 'N', 'F', 'O', 'I', 'N', 'A', 'M', 5, 0, 0, 0, 'P', 'o', 'n', 'g', 0, 0 };
+    std::vector<uint8_t> odd = { 1, 2, 3 };
+
+    std::vector<uint8_t> samples((size_t)NumWaveFrames * blockAlign);
+    for (size_t i = 0; i < samples.size(); ++i)
+        samples[i] = (uint8_t)(i * 31);
+
+    std::vector<uint8_t> chunks;
+    Append32(chunks, MakeFourCC('W', 'A', 'V', 'E'));
+    AppendChunk(chunks, MakeFourCC('f', 'm', 't', ' '), fmt);
+    AppendChunk(chunks, MakeFourCC('L', 'I', 'S', 'T'), list);
+    AppendChunk(chunks, MakeFourCC('j', 'u', 'n', 'k'), odd);
+    AppendChunk(chunks, MakeFourCC('d', 'a', 't', 'a'), samples);
+
+    std::vector<uint8_t> wave;
+    Append32(wave, MakeFourCC('R', 'I', 'F', 'F'));
+    Append32(wave, (uint32_t)chunks.size());
+    wave.insert(wave.end(), chunks.begin(), chunks.end());
+
+    return wave;
+}
+
+// How Audio::LoadWavFile used to parse: the file copied into a buffer, the samples copied out of it
+static size_t ParseCopying(const std::vector<uint8_t>& file)
+{
+    uint8_t* pFile = new uint8_t[file.size()];
+    memcpy(pFile, file.data(), file.size());
+
+    size_t numSampleBytes = 0;
+    size_t pos = 12;
+    while (file.size() - pos >= 8)
+    {
+        uint32_t type;
+        uint32_t length;
+        memcpy(&type, pFile + pos, sizeof(type));
+        memcpy(&length, pFile + pos + 4, sizeof(length));
+        pos += 8;
+        if (type == MakeFourCC('d', 'a', 't', 'a'))
+        {
+            uint8_t* pSamples = new uint8_t[length];
+            memcpy(pSamples, pFile + pos, length);
+            numSampleBytes = length;
+            delete[] pSamples;
+            break;
+        }
+        pos += length + (length & 1);
+    }
+
+    delete[] pFile;
+
+    return numSampleBytes;
+}
+
+// True if the parse failed, or succeeded without anything pointing outside the data
+static bool StaysInBounds(const std::vector<uint8_t>& data, size_t size)
+{
+    WaveFile wave;
+    if (!ReadWaveFile(std::span<const uint8_t>(data.data(), size), wave))
+        return true;
+
+    const uint8_t* pEnd = data.data() + size;
+    return wave.samples.data() >= data.data() && wave.samples.data() + wave.samples.size() <= pEnd &&
+        (wave.info.empty() || (wave.info.data() >= data.data() && wave.info.data() + wave.info.size() <= pEnd));
+}
+
+void RunWaveFileBenchmark()
+{
+    const int numFormats = (int)(sizeof(s_waveFormats) / sizeof(s_waveFormats[0]));
+    std::vector<std::vector<uint8_t>> waves;
+    size_t totalBytes = 0;
+    bool ok = true;
+    for (const BenchmarkWaveFormat& format : s_waveFormats)
+    {
+        waves.push_back(MakeWave(format));
+        totalBytes += waves.back().size();
+
+        // Parsed in place, with the format resolved
+        const std::vector<uint8_t>& wave = waves.back();
+        WaveFile parsed;
+        ok &= ReadWaveFile(wave, parsed) && parsed.GetNumFrames() == NumWaveFrames &&
+            parsed.format.numChannels == format.numChannels && parsed.format.bitsPerSample == format.bitsPerSample &&
+            parsed.format.channelMask == (format.formatTag == 0xfffe ? 0x3u : 0u) &&
+            parsed.samples.data() > wave.data() && parsed.samples.data() + parsed.samples.size() == wave.data() + wave.size() &&
+            parsed.info.size() == 18 && memcmp(parsed.info.data(), "INFO", 4) == 0;
+    }
+
+    // Every truncation of a file must fail or stay within the bytes left, and so must every corrupted header byte
+    int numDamaged = 0;
+    int numRejected = 0;
+    const std::vector<uint8_t>& headerWave = waves[3];
+    for (size_t size = 0; size < headerWave.size(); ++size)
+    {
+        WaveFile wave;
+        numRejected += ReadWaveFile(std::span<const uint8_t>(headerWave.data(), size), wave) ? 0 : 1;
+        ok &= StaysInBounds(headerWave, size);
+        ++numDamaged;
+    }
+    for (size_t pos = 0; pos < 96; ++pos)
+    {
+        static const uint8_t corruptions[] = { 0x00, 0x01, 0x7f, 0x80, 0xff };
+        for (uint8_t value : corruptions)
+        {
+            std::vector<uint8_t> damaged = headerWave;
+            damaged[pos] = value;
+            ok &= StaysInBounds(damaged, damaged.size());
+            ++numDamaged;
+        }
+    }
+
+    size_t copiedBytes = 0;
+    BenchmarkTimer copyTimer;
+    for (int parse = 0; parse < NumWaveParses; ++parse)
+        copiedBytes += ParseCopying(waves[parse % numFormats]);
+    double copySeconds = copyTimer.GetElapsedSeconds();
+
+    size_t spannedBytes = 0;
+    BenchmarkTimer spanTimer;
+    for (int parse = 0; parse < NumWaveParses; ++parse)
+    {
+        WaveFile wave;
+        ok &= ReadWaveFile(waves[parse % numFormats], wave);
+        spannedBytes += wave.samples.size();
+    }
+    double spanSeconds = spanTimer.GetElapsedSeconds();
+    ok &= (copiedBytes == spannedBytes);
+
+    double megabytes = (double)totalBytes * NumWaveParses / numFormats / (1024.0 * 1024.0);
+    printf("%d formats, %zu KB on average\n", numFormats, totalBytes / numFormats / 1024);
+    printf("Copying parser:   %8.1f ns per file, %8.0f MB/s\n", copySeconds / NumWaveParses * 1e9, megabytes / copySeconds);
+    printf("In place (spans): %8.1f ns per file, %8.0f MB/s (%.0fx)\n", spanSeconds / NumWaveParses * 1e9, megabytes / spanSeconds,
+        copySeconds / spanSeconds);
+    printf("%d damaged files, none read out of bounds (%d of %zu truncations rejected)%s\n", numDamaged, numRejected,
+        headerWave.size(), ok ? "" : " FAILED");
+}
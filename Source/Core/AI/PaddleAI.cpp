@@ -0,0 +1,140 @@
+#include "PaddleAI.h"
+
+bool PredictBallY(Real posX, Real posY, Real velocityX, Real velocityY, Real targetX,
+    Real minY, Real maxY, Real& outY, Real& outTime)
+{
+    if (velocityX == Real(0))
+        return false;
+
+    Real time = (targetX - posX) / velocityX;
+    if (time < Real(0))
+        return false;
+
+    Real range = maxY - minY;
+    if (range <= Real(0))
+    {
+        outY = minY;
+        outTime = time;
+        return true;
+    }
+
+    // Unfold the bounces: moving through a wall continues into a mirrored copy of the field. Two copies
+    // make one period, fold the unbounded position back into it.
+    Real period = range + range;
+    Real unfolded = RealMod(posY - minY + velocityY * time, period);
+    if (unfolded < Real(0))
+        unfolded += period;
+
+    outY = minY + ((unfolded <= range) ? unfolded : period - unfolded);
+    outTime = time;
+    return true;
+}
+
+PaddleAI::PaddleAI(size_t paddleIndex, const PaddleAIDifficulty& difficulty, uint32_t seed)
+{
+    m_paddleIndex           = paddleIndex;
+    m_difficulty            = difficulty;
+
+    Reset(seed);
+}
+
+void PaddleAI::Reset(uint32_t seed)
+{
+    m_random = (seed != 0) ? seed : 1;
+
+    m_seenVelocity = Vec2(0.0f, 0.0f);
+    m_planPending = false;
+    m_reactDelay = Real(0);
+    m_hasTarget = false;
+    m_targetY = Real(0);
+}
+
+PaddleAction PaddleAI::Decide(const Match& match, Real deltaTime)
+{
+    if (match.GetState() != GameState::Running)
+    {
+        m_seenVelocity = Vec2(0.0f, 0.0f);
+        m_planPending = false;
+        m_hasTarget = false;
+        return PaddleAction::None;
+    }
+
+    // Counted down rather than compared against a running clock, which would overflow in fixed point
+    if (m_planPending)
+        m_reactDelay -= deltaTime;
+
+    // Notice a new trajectory, and react to it once the reaction time has passed
+    const Ball& ball = match.GetBall();
+    if (ball.velocity.x != m_seenVelocity.x || ball.velocity.y != m_seenVelocity.y)
+    {
+        m_seenVelocity = ball.velocity;
+        m_planPending = true;
+        m_reactDelay = Real(m_difficulty.reactionTime);
+    }
+
+    if (m_planPending && m_reactDelay <= Real(0))
+    {
+        m_planPending = false;
+        Plan(match);
+    }
+
+    if (!m_hasTarget)
+        return PaddleAction::None;
+
+    // Stop within half a step's movement of the target, instead of overshooting it back and forth
+    const Paddle& paddle = match.GetPaddle(m_paddleIndex);
+    Real deadZone = match.GetRules().paddleSpeed[m_paddleIndex] * deltaTime * Real(0.5f);
+
+    if (paddle.pos.y < m_targetY - deadZone)
+        return PaddleAction::Up;
+    if (paddle.pos.y > m_targetY + deadZone)
+        return PaddleAction::Down;
+
+    return PaddleAction::None;
+}
+
+void PaddleAI::Plan(const Match& match)
+{
+    const Ball& ball = match.GetBall();
+    const Paddle& paddle = match.GetPaddle(m_paddleIndex);
+    const Vec2& worldBounds = match.GetWorldBounds();
+
+    Real halfWidths = (paddle.scale.x + ball.scale.x) * Real(0.5f);
+    Real ballHalfHeight = ball.scale.y * Real(0.5f);
+
+    // The ball's center touches the paddle one half width (of each) in front of the paddle's center
+    Real targetX = (paddle.pos.x > ball.pos.x) ? paddle.pos.x - halfWidths : paddle.pos.x + halfWidths;
+
+    Real interceptY;
+    Real interceptTime;
+    if (PredictBallY(ball.pos.x, ball.pos.y, ball.velocity.x, ball.velocity.y, targetX,
+        ballHalfHeight, worldBounds.y - ballHalfHeight, interceptY, interceptTime))
+    {
+        m_targetY = interceptY + Real(m_difficulty.aimError) * NextRandom();
+    }
+    else
+    {
+        // The ball is moving away; wait in the middle
+        m_targetY = worldBounds.y * Real(0.5f);
+    }
+
+    // The aim error can push the target past the walls, where the paddle's center can't go
+    Real paddleHalfHeight = paddle.scale.y * Real(0.5f);
+    if (m_targetY < paddleHalfHeight)
+        m_targetY = paddleHalfHeight;
+    else if (m_targetY > worldBounds.y - paddleHalfHeight)
+        m_targetY = worldBounds.y - paddleHalfHeight;
+
+    m_hasTarget = true;
+}
+
+Real PaddleAI::NextRandom()
+{
+    // xorshift32, mapped to [-1, 1]. Every step of the mapping is exact in float, so the conversion to
+    // Real is the same on every compiler.
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+
+    return Real((float)(m_random >> 8) / (float)(1 << 23) - 1.0f);
+}
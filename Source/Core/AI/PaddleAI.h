@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "Simulation/Match.h"
+
+// Computer player that predicts where the ball will cross its paddle's line instead of chasing the
+// ball's current height. The prediction is closed form: the ball's path is unfolded through the top
+// and bottom walls, so any number of bounces costs the same. A new prediction is only made when the
+// ball's velocity changes (serve, wall or paddle bounce); every other step just steers towards it.
+//
+// How good the AI plays is set by its reaction time (how long after a bounce it notices the new
+// direction) and its aim error (a random offset added to every prediction), not by its speed.
+//
+// All of it is computed in Real, so in fixed point builds (PONG_FIXED_POINT) the AI's decisions are as
+// bit-identical across compilers as the simulation it plays in.
+
+struct PaddleAIDifficulty
+{
+    float   reactionTime;   // Seconds between the ball changing direction and the AI reacting to it
+    float   aimError;       // Largest random offset of the predicted intercept, in world units
+
+    static PaddleAIDifficulty Easy() { return { 0.30f, 45.0f }; }
+    static PaddleAIDifficulty Medium() { return { 0.15f, 25.0f }; }
+    static PaddleAIDifficulty Hard() { return { 0.05f, 8.0f }; }
+    static PaddleAIDifficulty Perfect() { return { 0.0f, 0.0f }; }
+};
+
+// Height at which a ball starting at (posX, posY) with the given velocity reaches x = targetX, with
+// wall bounces folded in. The ball's center stays within [minY, maxY]. Returns false if the ball never
+// gets there (it moves away or not at all horizontally). In fixed point the distance travelled must
+// stay within Real's range, which predictions over a field's width do by far.
+bool PredictBallY(Real posX, Real posY, Real velocityX, Real velocityY, Real targetX,
+    Real minY, Real maxY, Real& outY, Real& outTime);
+
+class PaddleAI
+{
+    size_t              m_paddleIndex;
+    PaddleAIDifficulty  m_difficulty;
+    uint32_t            m_random;
+
+    Vec2                m_seenVelocity;     // Ball velocity the current plan (or pending plan) is based on
+    bool                m_planPending;      // Waiting for the reaction time to pass before planning
+    Real                m_reactDelay;       // Seconds until the pending plan kicks in
+    bool                m_hasTarget;        // False until the first plan of a rally
+    Real                m_targetY;          // Paddle center height to steer to, within the paddle's reach
+
+public:
+    PaddleAI(size_t paddleIndex = 1, const PaddleAIDifficulty& difficulty = PaddleAIDifficulty::Medium(), uint32_t seed = 1);
+
+    void SetDifficulty(const PaddleAIDifficulty& difficulty) { m_difficulty = difficulty; }
+    const PaddleAIDifficulty& GetDifficulty() const { return m_difficulty; }
+
+    // Forgets the current plan, e.g. when starting a new match
+    void Reset(uint32_t seed);
+
+    // Call once per step, before Match::Step()
+    PaddleAction Decide(const Match& match, Real deltaTime);
+
+    bool HasTarget() const { return m_hasTarget; }
+    Real GetTargetY() const { return m_targetY; }
+
+private:
+    void Plan(const Match& match);
+    Real NextRandom();
+};
@@ -0,0 +1,165 @@
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include "VectorEnvironment.h"
+#include "Threading/JobSystem.h"
+
+// Environments are stepped in blocks of whole cache lines of every (64-byte aligned) array
+static const size_t EnvironmentBlockSize = 64;
+
+static const float VelocityScale = 1.0f / 500.0f;
+
+EnvironmentConfig::EnvironmentConfig()
+{
+    stepSeconds             = 1.0f / 120.0f;
+    frameSkip               = 1;
+    agentPaddle             = 0;
+    maxEpisodeSteps         = 0;
+}
+
+VectorEnvironment::VectorEnvironment(size_t numEnvironments, const EnvironmentConfig& config, JobSystem* pJobs)
+    : m_config(config)
+    , m_batch(numEnvironments, config.rules)
+{
+    assert(config.agentPaddle < Match::NumPaddles && config.frameSkip > 0);
+
+    m_pJobs = pJobs;
+
+    m_inputs.resize(numEnvironments);
+    m_random.assign(numEnvironments, 1);
+    m_episodeSteps.assign(numEnvironments, 0);
+}
+
+void VectorEnvironment::Reset(const uint32_t* seeds, float* observations)
+{
+    for (size_t i = 0; i < GetNumEnvironments(); ++i)
+    {
+        // Spread similar seeds apart (and avoid 0, which xorshift can't leave)
+        m_random[i] = (seeds[i] * 2654435761u) | 1;
+        ResetEnvironment(i);
+    }
+
+    WriteObservations(0, GetNumEnvironments(), observations);
+}
+
+void VectorEnvironment::Step(const PaddleAction* actions, float* observations, float* rewards, uint8_t* dones)
+{
+    size_t numBlocks = (GetNumEnvironments() + EnvironmentBlockSize - 1) / EnvironmentBlockSize;
+    if (m_pJobs == nullptr)
+    {
+        StepRange(0, GetNumEnvironments(), actions, observations, rewards, dones);
+        return;
+    }
+
+    m_pJobs->ParallelFor(numBlocks, 4, [this, actions, observations, rewards, dones](size_t beginBlock, size_t endBlock)
+    {
+        StepRange(beginBlock * EnvironmentBlockSize, std::min(endBlock * EnvironmentBlockSize, GetNumEnvironments()),
+            actions, observations, rewards, dones);
+    });
+}
+
+void VectorEnvironment::StepRange(size_t first, size_t last, const PaddleAction* actions, float* observations, float* rewards, uint8_t* dones)
+{
+    const size_t agent = m_config.agentPaddle;
+    const size_t opponent = 1 - agent;
+    const Real deltaTime = Real(m_config.stepSeconds);
+
+    // Keep the score difference in the reward slot until the step is done. A match that is over
+    // doesn't change any more, so the difference covers every skipped frame.
+    for (size_t i = first; i < last; ++i)
+    {
+        int difference = m_batch.GetPaddleScore1(i) - m_batch.GetPaddleScore2(i);
+        rewards[i] = (float)(agent == 0 ? difference : -difference);
+    }
+
+    for (int frame = 0; frame < m_config.frameSkip; ++frame)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            // The opponent chases the ball, like ChaseBallAction()
+            Real ballY = m_batch.GetBallPos(i).y;
+            Real opponentY = m_batch.GetPaddlePos(i, opponent).y;
+
+            MatchInput& input = m_inputs[i];
+            input.paddles[agent] = actions[i];
+            input.paddles[opponent] = (opponentY < ballY) ? PaddleAction::Up : (opponentY > ballY) ? PaddleAction::Down : PaddleAction::None;
+            input.start = true;
+        }
+
+        m_batch.StepRange(first, last, m_inputs.data(), deltaTime);
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+        int difference = m_batch.GetPaddleScore1(i) - m_batch.GetPaddleScore2(i);
+        rewards[i] = (float)(agent == 0 ? difference : -difference) - rewards[i];
+
+        ++m_episodeSteps[i];
+
+        bool done = m_batch.IsOver(i) || (m_config.maxEpisodeSteps != 0 && m_episodeSteps[i] >= m_config.maxEpisodeSteps);
+        dones[i] = done ? 1 : 0;
+
+        if (done)
+            ResetEnvironment(i);
+    }
+
+    WriteObservations(first, last, observations);
+}
+
+void VectorEnvironment::ResetEnvironment(size_t index)
+{
+    // Serve towards a random side, at a random angle
+    const Vec2& serve = m_config.rules.ballServeVelocity;
+    float speedX = fabsf(ToFloat(serve.x));
+    float speedY = fabsf(ToFloat(serve.y)) * (0.5f + (NextRandom(index) & 0xffff) * (1.0f / 65536.0f));
+
+    float velocityX = (NextRandom(index) & 1) ? speedX : -speedX;
+    float velocityY = (NextRandom(index) & 1) ? speedY : -speedY;
+
+    m_batch.Reset(index, Vec2(Real(velocityX), Real(velocityY)));
+    m_episodeSteps[index] = 0;
+
+    // Initializing -> WaitingForPlayers -> Running, so that the first observation already shows the serve
+    MatchInput& input = m_inputs[index];
+    input = MatchInput();
+    input.start = true;
+
+    for (int i = 0; i < 2; ++i)
+        m_batch.StepRange(index, index + 1, m_inputs.data(), Real(0.0f));
+}
+
+void VectorEnvironment::WriteObservations(size_t first, size_t last, float* observations) const
+{
+    const size_t agent = m_config.agentPaddle;
+    const size_t opponent = 1 - agent;
+
+    const float scaleX = 2.0f / ToFloat(m_config.rules.worldWidth);
+    const float scaleY = 2.0f / ToFloat(m_config.rules.worldHeight);
+
+    // Mirror the field for the right paddle, so the agent always plays from the left
+    const float mirror = (agent == 0) ? 1.0f : -1.0f;
+
+    for (size_t i = first; i < last; ++i)
+    {
+        Vec2 ballPos = m_batch.GetBallPos(i);
+        Vec2 ballVelocity = m_batch.GetBallVelocity(i);
+
+        float* pObservation = observations + i * ObservationSize;
+        pObservation[0] = mirror * (ToFloat(ballPos.x) * scaleX - 1.0f);
+        pObservation[1] = ToFloat(ballPos.y) * scaleY - 1.0f;
+        pObservation[2] = mirror * ToFloat(ballVelocity.x) * VelocityScale;
+        pObservation[3] = ToFloat(ballVelocity.y) * VelocityScale;
+        pObservation[4] = ToFloat(m_batch.GetPaddlePos(i, agent).y) * scaleY - 1.0f;
+        pObservation[5] = ToFloat(m_batch.GetPaddlePos(i, opponent).y) * scaleY - 1.0f;
+    }
+}
+
+uint32_t VectorEnvironment::NextRandom(size_t index)
+{
+    uint32_t x = m_random[index];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    m_random[index] = x;
+    return x;
+}
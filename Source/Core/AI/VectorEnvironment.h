@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Simulation/MatchBatch.h"
+#include "Platform/AlignedAllocator.h"
+
+class JobSystem;
+
+struct EnvironmentConfig
+{
+    MatchRules  rules;
+    float       stepSeconds;        // Simulated time per simulation step
+    int         frameSkip;          // Simulation steps per environment step, repeating the action
+    size_t      agentPaddle;        // The paddle the actions control; the other one is played by the chase AI
+    uint32_t    maxEpisodeSteps;    // Episodes end (without reward) after this many environment steps; 0 for no limit
+
+    EnvironmentConfig();
+};
+
+// Many Pong environments stepped together, for training paddle agents: Reset(seeds), then
+// Step(actions) -> observations, rewards, dones. All results are written to caller provided arrays
+// and nothing is allocated per step.
+//
+// Every environment is one match of a MatchBatch under the usual rules, played until one side has
+// the winning score. The agent earns +1 for every point it scores and -1 for every point it concedes.
+// Environments that finish are reset right away (with a new serve derived from their seed), and the
+// observation returned for them is the first one of the new episode.
+//
+// Observations are ObservationSize floats per environment, seen from the agent's side (the agent
+// always plays from the left, x grows towards the opponent):
+//   ball x, ball y, ball velocity x, ball velocity y, agent paddle y, opponent paddle y
+// Positions are scaled to [-1, 1] over the field, velocities by 1/500.
+//
+// With a job system, environments are stepped in blocks of 64 that span whole cache lines of every
+// array, so threads never write to the same line. That holds for the caller's arrays too only if
+// they start 64-byte aligned (e.g. allocated with AlignedAllocator<T, 64>).
+class VectorEnvironment
+{
+    template <typename T>
+    using EnvironmentArray = std::vector<T, AlignedAllocator<T, 64>>;
+
+    EnvironmentConfig               m_config;
+    MatchBatch                      m_batch;
+    JobSystem*                      m_pJobs;
+
+    EnvironmentArray<MatchInput>    m_inputs;
+    EnvironmentArray<uint32_t>      m_random;
+    EnvironmentArray<uint32_t>      m_episodeSteps;
+
+public:
+    static const size_t ObservationSize = 6;
+
+    // With a job system, steps are spread over its threads
+    explicit VectorEnvironment(size_t numEnvironments, const EnvironmentConfig& config = EnvironmentConfig(), JobSystem* pJobs = nullptr);
+
+    size_t GetNumEnvironments() const { return m_batch.GetCount(); }
+    const EnvironmentConfig& GetConfig() const { return m_config; }
+    const MatchBatch& GetBatch() const { return m_batch; }
+
+    // seeds: one per environment. observations: GetNumEnvironments() * ObservationSize floats.
+    void Reset(const uint32_t* seeds, float* observations);
+
+    // actions: one per environment. rewards: one per environment. dones: 1 where an episode ended.
+    void Step(const PaddleAction* actions, float* observations, float* rewards, uint8_t* dones);
+
+private:
+    void StepRange(size_t first, size_t last, const PaddleAction* actions, float* observations, float* rewards, uint8_t* dones);
+    void ResetEnvironment(size_t index);
+    void WriteObservations(size_t first, size_t last, float* observations) const;
+    uint32_t NextRandom(size_t index);
+};
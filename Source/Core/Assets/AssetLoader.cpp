@@ -0,0 +1,119 @@
+#include <cassert>
+#include "AssetLoader.h"
+
+AssetLoader::AssetLoader(JobSystem* pJobs, const AssetPack* pAssets)
+{
+    m_pJobs                 = pJobs;
+    m_pAssets               = pAssets;
+    m_started               = false;
+    m_decodeOnUpdate        = false;
+    m_nextDecode            = 0;
+    m_numDecoded            = 0;
+    m_numFinalized          = 0;
+    m_pFailedRequest        = nullptr;
+}
+
+AssetLoader::~AssetLoader()
+{
+    // The jobs refer to the requests
+    if (m_started)
+        m_pJobs->Wait(m_decoding);
+}
+
+bool AssetLoader::Add(const char* name, DecodeFunction decode, FinalizeFunction finalize)
+{
+    assert(!m_started);
+
+    std::unique_ptr<Request> pRequest(new Request());
+    if (!m_pAssets->FindAsset(name, pRequest->pData, pRequest->size))
+        return false;
+
+    pRequest->name = name;
+    pRequest->decode = std::move(decode);
+    pRequest->finalize = std::move(finalize);
+    pRequest->state = Request_Queued;
+    m_requests.push_back(std::move(pRequest));
+
+    return true;
+}
+
+void AssetLoader::Start()
+{
+    assert(!m_started);
+    m_started = true;
+
+    // Jobs would only run in Wait(), which Update() doesn't call
+    if (m_pJobs->GetNumThreads() == 1)
+    {
+        m_decodeOnUpdate = true;
+        return;
+    }
+
+    for (std::unique_ptr<Request>& pRequest : m_requests)
+    {
+        Request* pDecoding = pRequest.get();
+        m_pJobs->Run([this, pDecoding]() { Decode(*pDecoding); }, &m_decoding);
+    }
+}
+
+void AssetLoader::Decode(Request& request)
+{
+    bool decoded = !request.decode || request.decode(request.pData, request.size);
+    request.state.store(decoded ? Request_Decoded : Request_Failed, std::memory_order_release);
+    m_numDecoded.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool AssetLoader::Update()
+{
+    assert(m_started);
+
+    if (m_pFailedRequest != nullptr)
+        return false;
+
+    if (m_decodeOnUpdate && m_nextDecode < m_requests.size())
+        Decode(*m_requests[m_nextDecode++]);
+
+    for (std::unique_ptr<Request>& pRequest : m_requests)
+    {
+        uint32_t state = pRequest->state.load(std::memory_order_acquire);
+        if (state == Request_Decoded)
+        {
+            if (pRequest->finalize && !pRequest->finalize())
+                state = Request_Failed;
+            else
+                state = Request_Finalized;
+
+            pRequest->state.store(state, std::memory_order_relaxed);
+            if (state == Request_Finalized)
+                ++m_numFinalized;
+        }
+
+        if (state == Request_Failed)
+        {
+            m_pFailedRequest = pRequest.get();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool AssetLoader::Wait()
+{
+    m_pJobs->Wait(m_decoding);
+
+    while (m_decodeOnUpdate && m_nextDecode < m_requests.size())
+        Decode(*m_requests[m_nextDecode++]);
+
+    return Update();
+}
+
+float AssetLoader::GetProgress() const
+{
+    if (m_requests.empty())
+        return 1.0f;
+
+    size_t numSteps = m_numDecoded.load(std::memory_order_relaxed) + m_numFinalized;
+
+    return (float)numSteps / (float)(m_requests.size() * 2);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Assets/AssetPack.h"
+#include "Threading/JobSystem.h"
+
+// Loads assets from an AssetPack in the background. Every asset is decoded by a job on the job system,
+// all of them in parallel, and then finalized by Update() on the thread that owns the loader; that is
+// where resources that belong to that thread (e.g. sound buffers) are created. Update() never blocks, so
+// the owner can keep drawing a loading screen from GetProgress() while the assets come in.
+class AssetLoader
+{
+public:
+    // Runs on a worker thread with the asset's data from the pack. False if the asset can't be used.
+    typedef std::function<bool(const uint8_t* pData, size_t size)> DecodeFunction;
+
+    // Runs on the owning thread once the asset is decoded. False if the asset can't be used.
+    typedef std::function<bool()> FinalizeFunction;
+
+private:
+    enum RequestState : uint32_t
+    {
+        Request_Queued,
+        Request_Decoded,
+        Request_Finalized,
+        Request_Failed,
+    };
+
+    struct Request
+    {
+        std::string             name;
+        const uint8_t*          pData;
+        size_t                  size;
+        DecodeFunction          decode;
+        FinalizeFunction        finalize;
+        std::atomic<uint32_t>   state;          // RequestState, set to Decoded or Failed by the decode job
+    };
+
+    JobSystem*                              m_pJobs;
+    const AssetPack*                        m_pAssets;
+
+    std::vector<std::unique_ptr<Request>>   m_requests;
+    JobCounter                              m_decoding;
+    bool                                    m_started;
+    bool                                    m_decodeOnUpdate;   // No worker threads, so Update() decodes
+    size_t                                  m_nextDecode;       // With m_decodeOnUpdate
+
+    std::atomic<size_t>                     m_numDecoded;
+    size_t                                  m_numFinalized;
+    const Request*                          m_pFailedRequest;
+
+public:
+    // Both have to outlive the loader
+    AssetLoader(JobSystem* pJobs, const AssetPack* pAssets);
+
+    // Waits for the decode jobs that are still running
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // False if the pack has no asset of that name. Only before Start().
+    bool Add(const char* name, DecodeFunction decode, FinalizeFunction finalize = nullptr);
+
+    // Starts decoding every asset added
+    void Start();
+
+    // Finalizes the assets decoded so far, without waiting for the others. False once an asset has failed.
+    // Without worker threads it decodes one asset itself first, so progress is still drawn between assets.
+    bool Update();
+
+    // Runs jobs until every asset is decoded, then finalizes them. For tools that have nothing to draw.
+    bool Wait();
+
+    bool IsDone() const { return m_numFinalized == m_requests.size(); }
+
+    // Decoding and finalizing count half each, from 0 to 1
+    float GetProgress() const;
+
+    // Null unless Update() or Wait() has returned false
+    const char* GetFailedAsset() const { return (m_pFailedRequest != nullptr) ? m_pFailedRequest->name.c_str() : nullptr; }
+
+private:
+    void Decode(Request& request);
+};
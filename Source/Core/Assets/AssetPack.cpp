@@ -0,0 +1,210 @@
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "AssetPack.h"
+#include "Platform/File.h"
+#include "Platform/Hash.h"
+
+static const uint32_t PackMagic = 0x4b415050; // "PPAK"
+static const uint32_t PackVersion = 1;
+
+struct PackHeader
+{
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    numEntries;
+    uint32_t    reserved;
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader is stored as is in pack files");
+
+static size_t AlignOffset(size_t offset)
+{
+    return (offset + AssetPack::Alignment - 1) & ~(AssetPack::Alignment - 1);
+}
+
+// Checks the header and the table of contents of a mapped pack and returns the table
+static bool FindEntries(const uint8_t* pData, size_t size, const AssetPackEntry*& pEntries, size_t& numEntries)
+{
+    if (pData == nullptr || size < sizeof(PackHeader))
+        return false;
+
+    PackHeader header;
+    memcpy(&header, pData, sizeof(header));
+    if (header.magic != PackMagic || header.version != PackVersion)
+        return false;
+
+    uint64_t tableEnd = sizeof(PackHeader) + (uint64_t)header.numEntries * sizeof(AssetPackEntry);
+    if (tableEnd > size)
+        return false;
+
+    const AssetPackEntry* pTable = (const AssetPackEntry*)(pData + sizeof(PackHeader));
+    for (uint32_t i = 0; i < header.numEntries; ++i)
+    {
+        const AssetPackEntry& entry = pTable[i];
+        if (entry.name[0] == '\0' || memchr(entry.name, '\0', sizeof(entry.name)) == nullptr)
+            return false;
+
+        // Sorted, so FindEntry() can binary search
+        if (i > 0 && strcmp(pTable[i - 1].name, entry.name) >= 0)
+            return false;
+
+        if ((entry.offset % AssetPack::Alignment) != 0 || entry.offset < tableEnd || entry.offset > size ||
+            entry.size > size - entry.offset)
+        {
+            return false;
+        }
+    }
+
+    pEntries = pTable;
+    numEntries = header.numEntries;
+
+    return true;
+}
+
+AssetPack::AssetPack()
+{
+    m_pEntries              = nullptr;
+    m_numEntries            = 0;
+}
+
+bool AssetPack::Open(const char* pFilename)
+{
+    Close();
+
+    if (!m_file.Open(pFilename))
+        return false;
+
+    if (!FindEntries(m_file.GetData(), m_file.GetSize(), m_pEntries, m_numEntries))
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void AssetPack::Close()
+{
+    m_file.Close();
+    m_pEntries = nullptr;
+    m_numEntries = 0;
+}
+
+const AssetPackEntry* AssetPack::FindEntry(const char* name) const
+{
+    const AssetPackEntry* pEnd = m_pEntries + m_numEntries;
+    const AssetPackEntry* pEntry = std::lower_bound(m_pEntries, pEnd, name,
+        [](const AssetPackEntry& entry, const char* value) { return strcmp(entry.name, value) < 0; });
+    if (pEntry == pEnd || strcmp(pEntry->name, name) != 0)
+        return nullptr;
+
+    return pEntry;
+}
+
+bool AssetPack::FindAsset(const char* name, const uint8_t*& outData, size_t& outSize) const
+{
+    const AssetPackEntry* pEntry = FindEntry(name);
+    if (pEntry == nullptr)
+        return false;
+
+    outData = m_file.GetData() + pEntry->offset;
+    outSize = (size_t)pEntry->size;
+
+    return true;
+}
+
+bool AssetPack::Verify() const
+{
+    for (size_t i = 0; i < m_numEntries; ++i)
+    {
+        const AssetPackEntry& entry = m_pEntries[i];
+        if (HashFnv1a(m_file.GetData() + entry.offset, (size_t)entry.size) != entry.hash)
+            return false;
+    }
+
+    return true;
+}
+
+bool AssetPackWriter::Add(const char* name, const void* pData, size_t size)
+{
+    size_t length = strlen(name);
+    if (length == 0 || length >= sizeof(AssetPackEntry::name))
+        return false;
+
+    for (const Asset& asset : m_assets)
+    {
+        if (asset.name == name)
+            return false;
+    }
+
+    const uint8_t* pBytes = (const uint8_t*)pData;
+    m_assets.push_back({ name, std::vector<uint8_t>(pBytes, pBytes + size) });
+
+    return true;
+}
+
+bool AssetPackWriter::AddFile(const char* name, const char* pFilename)
+{
+    MappedFile file;
+    if (!file.Open(pFilename))
+        return false;
+
+    return Add(name, file.GetData(), file.GetSize());
+}
+
+bool AssetPackWriter::Write(const char* pFilename) const
+{
+    std::vector<const Asset*> sorted;
+    for (const Asset& asset : m_assets)
+        sorted.push_back(&asset);
+    std::sort(sorted.begin(), sorted.end(), [](const Asset* pA, const Asset* pB) { return pA->name < pB->name; });
+
+    PackHeader header;
+    header.magic = PackMagic;
+    header.version = PackVersion;
+    header.numEntries = (uint32_t)sorted.size();
+    header.reserved = 0;
+
+    std::vector<AssetPackEntry> entries(sorted.size());
+    size_t offset = sizeof(PackHeader) + entries.size() * sizeof(AssetPackEntry);
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        AssetPackEntry& entry = entries[i];
+        memset(&entry, 0, sizeof(entry));
+        memcpy(entry.name, sorted[i]->name.c_str(), sorted[i]->name.size());
+
+        offset = AlignOffset(offset);
+        entry.offset = offset;
+        entry.size = sorted[i]->data.size();
+        entry.hash = HashFnv1a(sorted[i]->data.data(), sorted[i]->data.size());
+
+        offset += sorted[i]->data.size();
+    }
+
+    FILE* pFile = OpenStdioFile(pFilename, "wb");
+    if (pFile == nullptr)
+        return false;
+
+    bool written = fwrite(&header, sizeof(header), 1, pFile) == 1;
+    if (!entries.empty())
+        written = written && fwrite(entries.data(), sizeof(AssetPackEntry), entries.size(), pFile) == entries.size();
+
+    static const uint8_t padding[AssetPack::Alignment] = {};
+    size_t position = sizeof(PackHeader) + entries.size() * sizeof(AssetPackEntry);
+    for (size_t i = 0; i < sorted.size() && written; ++i)
+    {
+        const std::vector<uint8_t>& data = sorted[i]->data;
+        size_t paddingSize = entries[i].offset - position;
+        written = (paddingSize == 0 || fwrite(padding, paddingSize, 1, pFile) == 1) &&
+            (data.empty() || fwrite(data.data(), data.size(), 1, pFile) == 1);
+        position = entries[i].offset + data.size();
+    }
+
+    written = (fclose(pFile) == 0) && written;
+
+    if (!written)
+        remove(pFilename);
+
+    return written;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Platform/MappedFile.h"
+
+// The game's data files packed into one file, so starting the game maps a single file instead of
+// opening each asset and reading it into a buffer of its own. Loaders are given a pointer into the
+// mapping and use the data from there.
+//
+// Layout (little endian):
+//   header:  magic "PPAK" (u32), version (u32), count (u32), reserved (u32)
+//   entries: AssetPackEntry[count], sorted by name
+//   data:    the assets, each at an offset aligned to AssetPack::Alignment
+//
+// Every entry has a 64-bit FNV-1a hash of its data. Open() only checks the table of contents; Verify()
+// hashes the data too, which touches every page of the file.
+
+struct AssetPackEntry
+{
+    char        name[56];           // Zero terminated, e.g. "WallHit.wav"
+    uint64_t    offset;             // Of the data, from the start of the file
+    uint64_t    size;
+    uint64_t    hash;
+};
+
+static_assert(sizeof(AssetPackEntry) == 80, "AssetPackEntry is stored as is in pack files");
+
+class AssetPack
+{
+    MappedFile              m_file;
+    const AssetPackEntry*   m_pEntries;
+    size_t                  m_numEntries;
+
+public:
+    // Enough for the tables of baked assets (e.g. fonts) to be used in place
+    static const size_t Alignment = 16;
+
+    AssetPack();
+
+    bool Open(const char* pFilename);
+    void Close();
+
+    size_t GetNumAssets() const { return m_numEntries; }
+    const AssetPackEntry& GetEntry(size_t index) const { return m_pEntries[index]; }
+
+    // Null if the pack has no asset of that name
+    const AssetPackEntry* FindEntry(const char* name) const;
+
+    // Points into the mapped file and is valid until the pack is closed. False if the pack has no asset
+    // of that name.
+    bool FindAsset(const char* name, const uint8_t*& outData, size_t& outSize) const;
+
+    // Hashes the data of every asset and compares it with its entry
+    bool Verify() const;
+};
+
+class AssetPackWriter
+{
+    struct Asset
+    {
+        std::string             name;
+        std::vector<uint8_t>    data;
+    };
+
+    std::vector<Asset>      m_assets;
+
+public:
+    // False if the name is empty, too long or already added
+    bool Add(const char* name, const void* pData, size_t size);
+    bool AddFile(const char* name, const char* pFilename);
+
+    bool Write(const char* pFilename) const;
+};
@@ -0,0 +1,162 @@
+#include <cstring>
+#include "WaveFile.h"
+
+static const size_t ChunkHeaderSize = 8;
+
+static const uint16_t FormatPcm = 1;
+static const uint16_t FormatFloat = 3;
+static const uint16_t FormatExtensible = 0xfffe;
+
+// KSDATAFORMAT_SUBTYPE_PCM and KSDATAFORMAT_SUBTYPE_IEEE_FLOAT as stored in a file. They only differ in
+// their first two bytes, which hold the format tag.
+static const uint8_t SubFormatGuidTail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+
+// RIFF is little endian, as are the platforms the game runs on
+static uint16_t Read16(const uint8_t* pData)
+{
+    uint16_t value;
+    memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+static uint32_t Read32(const uint8_t* pData)
+{
+    uint32_t value;
+    memcpy(&value, pData, sizeof(value));
+    return value;
+}
+
+RiffReader::RiffReader(std::span<const uint8_t> data)
+{
+    m_data                  = data;
+    m_pos                   = 0;
+    m_failed                = false;
+}
+
+bool RiffReader::Next(RiffChunk& outChunk)
+{
+    if (m_failed || m_pos == m_data.size())
+        return false;
+
+    size_t remaining = m_data.size() - m_pos;
+    if (remaining < ChunkHeaderSize || Read32(m_data.data() + m_pos + 4) > remaining - ChunkHeaderSize)
+    {
+        m_failed = true;
+        return false;
+    }
+
+    uint32_t size = Read32(m_data.data() + m_pos + 4);
+    outChunk.id = Read32(m_data.data() + m_pos);
+    outChunk.data = m_data.subspan(m_pos + ChunkHeaderSize, size);
+    m_pos += ChunkHeaderSize + size;
+
+    // Odd sized chunks are followed by a padding byte, which some writers leave out after the last one
+    if ((size & 1) != 0 && m_pos < m_data.size())
+        ++m_pos;
+
+    return true;
+}
+
+static bool ReadWaveFormat(std::span<const uint8_t> chunk, WaveFormat& outFormat)
+{
+    if (chunk.size() < 16)
+        return false;
+
+    const uint8_t* pData = chunk.data();
+    uint16_t formatTag = Read16(pData);
+    outFormat.numChannels = Read16(pData + 2);
+    outFormat.samplesPerSecond = Read32(pData + 4);
+    outFormat.avgBytesPerSecond = Read32(pData + 8);
+    outFormat.blockAlign = Read16(pData + 12);
+    outFormat.bitsPerSample = Read16(pData + 14);
+    outFormat.channelMask = 0;
+
+    // WAVEFORMATEXTENSIBLE: cbSize, valid bits, channel mask, then the sub format GUID at 24
+    if (formatTag == FormatExtensible)
+    {
+        if (chunk.size() < 40 || Read16(pData + 16) < 22 || memcmp(pData + 26, SubFormatGuidTail, sizeof(SubFormatGuidTail)) != 0)
+            return false;
+
+        outFormat.channelMask = Read32(pData + 20);
+        formatTag = Read16(pData + 24);
+    }
+
+    switch (formatTag)
+    {
+        case FormatPcm:
+            if (outFormat.bitsPerSample != 8 && outFormat.bitsPerSample != 16 && outFormat.bitsPerSample != 24 &&
+                outFormat.bitsPerSample != 32)
+            {
+                return false;
+            }
+            outFormat.sampleType = WaveSampleType::Pcm;
+            break;
+
+        case FormatFloat:
+            if (outFormat.bitsPerSample != 32 && outFormat.bitsPerSample != 64)
+                return false;
+            outFormat.sampleType = WaveSampleType::Float;
+            break;
+
+        default:
+            return false;
+    }
+
+    return outFormat.numChannels > 0 && outFormat.samplesPerSecond > 0 &&
+        outFormat.blockAlign == outFormat.numChannels * (outFormat.bitsPerSample / 8);
+}
+
+bool ReadWaveFile(std::span<const uint8_t> data, WaveFile& outWave)
+{
+    if (data.size() < 12 || Read32(data.data()) != MakeFourCC('R', 'I', 'F', 'F') ||
+        Read32(data.data() + 8) != MakeFourCC('W', 'A', 'V', 'E'))
+    {
+        return false;
+    }
+
+    // The RIFF size counts the form type and the chunks, and may be followed by other data
+    uint32_t riffSize = Read32(data.data() + 4);
+    if (riffSize < 4 || riffSize > data.size() - 8)
+        return false;
+
+    WaveFile wave = WaveFile();
+    bool hasFormat = false;
+    bool hasSamples = false;
+
+    RiffReader reader(data.subspan(12, riffSize - 4));
+    RiffChunk chunk;
+    while (reader.Next(chunk))
+    {
+        switch (chunk.id)
+        {
+            case MakeFourCC('f', 'm', 't', ' '):
+                if (hasFormat || !ReadWaveFormat(chunk.data, wave.format))
+                    return false;
+                hasFormat = true;
+                break;
+
+            case MakeFourCC('d', 'a', 't', 'a'):
+                if (hasSamples)
+                    return false;
+                wave.samples = chunk.data;
+                hasSamples = true;
+                break;
+
+            case MakeFourCC('L', 'I', 'S', 'T'):
+                if (wave.info.empty())
+                    wave.info = chunk.data;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (reader.HasFailed() || !hasFormat || !hasSamples)
+        return false;
+
+    wave.samples = wave.samples.first(wave.samples.size() - wave.samples.size() % wave.format.blockAlign);
+    outWave = wave;
+
+    return true;
+}
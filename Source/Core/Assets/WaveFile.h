@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+// Reads RIFF WAVE files in place, e.g. from a MappedFile or an AssetPack entry. Nothing is copied: the
+// chunks and samples are spans into the file's data, which has to outlive them. Every chunk size is
+// checked against the data before it is used, so damaged or truncated files are rejected, not overrun.
+
+constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+{
+    return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+}
+
+struct RiffChunk
+{
+    uint32_t                    id;             // FourCC
+    std::span<const uint8_t>    data;           // Without the padding byte of odd sized chunks
+};
+
+// Walks the chunks of a RIFF form or LIST, in file order
+class RiffReader
+{
+    std::span<const uint8_t>    m_data;
+    size_t                      m_pos;
+    bool                        m_failed;
+
+public:
+    // The chunks that follow a form or list type
+    explicit RiffReader(std::span<const uint8_t> data);
+
+    // False after the last chunk, or at a chunk that runs past the end of the data (see HasFailed())
+    bool Next(RiffChunk& outChunk);
+
+    bool HasFailed() const { return m_failed; }
+};
+
+enum class WaveSampleType : uint8_t
+{
+    Pcm,                                        // Signed integers, except 8-bit which is unsigned
+    Float,                                      // IEEE floats
+};
+
+// The "fmt " chunk's fields. WAVE_FORMAT_EXTENSIBLE is resolved to the PCM or float format it wraps.
+struct WaveFormat
+{
+    WaveSampleType      sampleType;
+    uint16_t            numChannels;
+    uint32_t            samplesPerSecond;
+    uint32_t            avgBytesPerSecond;
+    uint16_t            blockAlign;             // Bytes per frame, one sample of every channel
+    uint16_t            bitsPerSample;          // 8, 16, 24 or 32 for PCM; 32 or 64 for float
+    uint32_t            channelMask;            // Speaker positions of WAVE_FORMAT_EXTENSIBLE files, 0 for other files
+};
+
+struct WaveFile
+{
+    WaveFormat                  format;
+    std::span<const uint8_t>    samples;        // The "data" chunk, cut to whole frames
+    std::span<const uint8_t>    info;           // The first "LIST" chunk's contents (e.g. INFO tags), empty if there is none
+
+    size_t GetNumFrames() const { return samples.size() / format.blockAlign; }
+};
+
+// False if the data isn't a valid WAV file of a supported format. Other chunks (e.g. "fact", "cue ") are skipped.
+bool ReadWaveFile(std::span<const uint8_t> data, WaveFile& outWave);
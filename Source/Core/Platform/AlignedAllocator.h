@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// Allocator for standard containers whose storage has to start on an Alignment byte boundary, e.g.
+// std::vector<float, AlignedAllocator<float, 64>> for arrays split between threads on cache lines.
+template <typename T, size_t Alignment>
+class AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count)
+    {
+        return (T*)::operator new(count * sizeof(T), std::align_val_t(Alignment));
+    }
+
+    void deallocate(T* p, size_t)
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
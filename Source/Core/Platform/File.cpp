@@ -0,0 +1,13 @@
+#include "File.h"
+
+FILE* OpenStdioFile(const char* pFilename, const char* pMode)
+{
+#ifdef _MSC_VER
+    FILE* pFile = nullptr;
+    if (fopen_s(&pFile, pFilename, pMode) != 0)
+        return nullptr;
+    return pFile;
+#else
+    return fopen(pFilename, pMode);
+#endif
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstdio>
+
+// fopen(), through fopen_s where the CRT deprecates fopen. Null if the file can't be opened.
+FILE* OpenStdioFile(const char* pFilename, const char* pMode);
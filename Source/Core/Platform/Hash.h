@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// 64-bit FNV-1a. Fast enough for content hashes of asset and cache files, not meant to resist attacks.
+// Pass the result back in as 'hash' to continue hashing more data.
+static const uint64_t Fnv1aBasis = 14695981039346656037ull;
+
+inline uint64_t HashFnv1a(const void* pData, size_t size, uint64_t hash = Fnv1aBasis)
+{
+    const uint8_t* pBytes = (const uint8_t*)pData;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= pBytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
@@ -0,0 +1,142 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+{
+    m_pData                 = nullptr;
+    m_size                  = 0;
+    m_hFile                 = INVALID_HANDLE_VALUE;
+    m_hMapping              = nullptr;
+}
+
+bool MappedFile::Open(const char* pFilename)
+{
+    Close();
+
+    m_hFile = CreateFileA(pFilename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_hFile, &size))
+    {
+        Close();
+        return false;
+    }
+
+    // Empty files can't be mapped, but are valid
+    if (size.QuadPart == 0)
+        return true;
+
+    m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_pData = (const uint8_t*)MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_pData == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_pData != nullptr)
+        UnmapViewOfFile(m_pData);
+    if (m_hMapping != nullptr)
+        CloseHandle(m_hMapping);
+    if (m_hFile != INVALID_HANDLE_VALUE)
+        CloseHandle(m_hFile);
+
+    m_pData = nullptr;
+    m_size = 0;
+    m_hFile = INVALID_HANDLE_VALUE;
+    m_hMapping = nullptr;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_hFile != INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile()
+{
+    m_pData                 = nullptr;
+    m_size                  = 0;
+    m_fd                    = -1;
+}
+
+bool MappedFile::Open(const char* pFilename)
+{
+    Close();
+
+    m_fd = open(pFilename, O_RDONLY);
+    if (m_fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(m_fd, &info) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    // Empty files can't be mapped, but are valid
+    if (info.st_size == 0)
+        return true;
+
+    void* pData = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (pData == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+
+    m_pData = (const uint8_t*)pData;
+    m_size = (size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_pData != nullptr)
+        munmap((void*)m_pData, m_size);
+    if (m_fd >= 0)
+        close(m_fd);
+
+    m_pData = nullptr;
+    m_size = 0;
+    m_fd = -1;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return m_fd >= 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
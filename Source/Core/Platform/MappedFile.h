@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file (MapViewOfFile on Windows, mmap elsewhere). The data is
+// paged in by the OS on first access, so opening a large file is cheap and only the parts that are
+// actually read cost I/O.
+class MappedFile
+{
+    const uint8_t*  m_pData;
+    size_t          m_size;
+
+#ifdef _WIN32
+    void*           m_hFile;
+    void*           m_hMapping;
+#else
+    int             m_fd;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* pFilename);
+    void Close();
+
+    bool IsOpen() const;
+
+    // Null for an empty file
+    const uint8_t* GetData() const { return m_pData; }
+    size_t GetSize() const { return m_size; }
+};
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include "Font.h"
+#include "Platform/File.h"
+
+static const uint32_t FontFileMagic = 0x544e4650; // "PFNT"
+static const uint32_t FontFileVersion = 1;
+
+static_assert(sizeof(FontFileHeader) == 24, "FontFileHeader is stored as is in font files");
+static_assert(sizeof(GlyphQuad) == 36, "GlyphQuad is stored as is in font files");
+
+// What an empty FontAtlas points to, so FindGlyph() needs no checks
+static const FontFileHeader s_emptyHeader = {};
+static const uint8_t s_noDirectGlyphs[FontAtlas::NumDirectGlyphs] = {};
+
+static const size_t DirectGlyphsOffset = sizeof(FontFileHeader);
+static const size_t DirectFlagsOffset = DirectGlyphsOffset + FontAtlas::NumDirectGlyphs * sizeof(GlyphQuad);
+static const size_t CodePointsOffset = DirectFlagsOffset + FontAtlas::NumDirectGlyphs;
+
+static size_t GetFontFileSize(uint32_t numSortedGlyphs)
+{
+    return CodePointsOffset + (size_t)numSortedGlyphs * (sizeof(uint32_t) + sizeof(GlyphQuad));
+}
+
+FontAtlasBuilder::FontAtlasBuilder(uint32_t size, uint32_t width, uint32_t height)
+{
+    m_size      = size;
+    m_width     = width;
+    m_height    = height;
+}
+
+void FontAtlasBuilder::AddGlyph(const Glyph& glyph)
+{
+    GlyphQuad quad;
+    quad.advance        = glyph.advance;
+    quad.planeLeft      = glyph.planeLeft;
+    quad.planeBottom    = glyph.planeBottom;
+    quad.planeRight     = glyph.planeRight;
+    quad.planeTop       = glyph.planeTop;
+
+    // The atlas bounds have their origin at the bottom, texture coordinates at the top
+    float width = (m_width > 0) ? (float)m_width : 1.0f;
+    float height = (m_height > 0) ? (float)m_height : 1.0f;
+    quad.u0             = glyph.atlasLeft / width;
+    quad.v0             = 1.0f - glyph.atlasTop / height;
+    quad.u1             = glyph.atlasRight / width;
+    quad.v1             = 1.0f - glyph.atlasBottom / height;
+
+    m_glyphs[glyph.unicode] = quad;
+}
+
+std::vector<uint8_t> FontAtlasBuilder::Bake() const
+{
+    uint32_t numSortedGlyphs = 0;
+    for (const auto& [codePoint, quad] : m_glyphs)
+    {
+        if (codePoint >= FontAtlas::NumDirectGlyphs)
+            ++numSortedGlyphs;
+    }
+
+    std::vector<uint8_t> data(GetFontFileSize(numSortedGlyphs), 0);
+
+    FontFileHeader header;
+    header.magic            = FontFileMagic;
+    header.version          = FontFileVersion;
+    header.size             = m_size;
+    header.width            = m_width;
+    header.height           = m_height;
+    header.numSortedGlyphs  = numSortedGlyphs;
+    memcpy(data.data(), &header, sizeof(header));
+
+    // The map is sorted, so the glyphs outside Latin-1 come out in code point order
+    size_t codePointOffset = CodePointsOffset;
+    size_t glyphOffset = CodePointsOffset + numSortedGlyphs * sizeof(uint32_t);
+    for (const auto& [codePoint, quad] : m_glyphs)
+    {
+        if (codePoint < FontAtlas::NumDirectGlyphs)
+        {
+            memcpy(&data[DirectGlyphsOffset + codePoint * sizeof(GlyphQuad)], &quad, sizeof(GlyphQuad));
+            data[DirectFlagsOffset + codePoint] = 1;
+            continue;
+        }
+
+        memcpy(&data[codePointOffset], &codePoint, sizeof(uint32_t));
+        memcpy(&data[glyphOffset], &quad, sizeof(GlyphQuad));
+        codePointOffset += sizeof(uint32_t);
+        glyphOffset += sizeof(GlyphQuad);
+    }
+
+    return data;
+}
+
+bool FontAtlasBuilder::Write(const char* fileName) const
+{
+    std::vector<uint8_t> data = Bake();
+
+    FILE* pFile = OpenStdioFile(fileName, "wb");
+    if (pFile == nullptr)
+        return false;
+
+    bool written = fwrite(data.data(), data.size(), 1, pFile) == 1;
+    written = (fclose(pFile) == 0) && written;
+
+    if (!written)
+        remove(fileName);
+
+    return written;
+}
+
+FontAtlas::FontAtlas()
+{
+    Detach();
+}
+
+FontAtlas::FontAtlas(FontAtlas&& other)
+{
+    Detach();
+    *this = std::move(other);
+}
+
+FontAtlas& FontAtlas::operator=(FontAtlas&& other)
+{
+    if (this == &other)
+        return *this;
+
+    // Moving the mapping or the vector keeps the data where it is, so the table pointers stay valid
+    m_pFile             = std::move(other.m_pFile);
+    m_data              = std::move(other.m_data);
+
+    m_pHeader           = other.m_pHeader;
+    m_pDirectGlyphs     = other.m_pDirectGlyphs;
+    m_pHasDirectGlyph   = other.m_pHasDirectGlyph;
+    m_pCodePoints       = other.m_pCodePoints;
+    m_pGlyphs           = other.m_pGlyphs;
+
+    other.Close();
+
+    return *this;
+}
+
+bool FontAtlas::Open(const char* fileName)
+{
+    Close();
+
+    std::unique_ptr<MappedFile> pFile(new MappedFile());
+    if (!pFile->Open(fileName) || !Attach(pFile->GetData(), pFile->GetSize()))
+        return false;
+
+    m_pFile = std::move(pFile);
+
+    return true;
+}
+
+bool FontAtlas::Open(const uint8_t* pData, size_t size)
+{
+    Close();
+
+    return Attach(pData, size);
+}
+
+bool FontAtlas::Load(std::vector<uint8_t>&& bakedData)
+{
+    Close();
+
+    if (!Attach(bakedData.data(), bakedData.size()))
+        return false;
+
+    m_data = std::move(bakedData);
+
+    return true;
+}
+
+void FontAtlas::Close()
+{
+    Detach();
+
+    m_pFile.reset();
+    m_data.clear();
+}
+
+bool FontAtlas::Attach(const uint8_t* pData, size_t size)
+{
+    // The tables are used in place, so they have to be aligned for their types
+    if (pData == nullptr || size < CodePointsOffset || ((uintptr_t)pData & 3) != 0)
+        return false;
+
+    const FontFileHeader* pHeader = (const FontFileHeader*)pData;
+    if (pHeader->magic != FontFileMagic || pHeader->version != FontFileVersion)
+        return false;
+
+    // Checked by count first, so the size can't overflow
+    if (pHeader->numSortedGlyphs > (size - CodePointsOffset) / (sizeof(uint32_t) + sizeof(GlyphQuad)) ||
+        GetFontFileSize(pHeader->numSortedGlyphs) != size)
+    {
+        return false;
+    }
+
+    // The binary search needs the code points sorted
+    const uint32_t* pCodePoints = (const uint32_t*)(pData + CodePointsOffset);
+    for (uint32_t i = 0; i < pHeader->numSortedGlyphs; ++i)
+    {
+        if (pCodePoints[i] < NumDirectGlyphs || (i > 0 && pCodePoints[i] <= pCodePoints[i - 1]))
+            return false;
+    }
+
+    m_pHeader           = pHeader;
+    m_pDirectGlyphs     = (const GlyphQuad*)(pData + DirectGlyphsOffset);
+    m_pHasDirectGlyph   = pData + DirectFlagsOffset;
+    m_pCodePoints       = pCodePoints;
+    m_pGlyphs           = (const GlyphQuad*)(pCodePoints + pHeader->numSortedGlyphs);
+
+    return true;
+}
+
+void FontAtlas::Detach()
+{
+    m_pHeader           = &s_emptyHeader;
+    m_pDirectGlyphs     = nullptr;
+    m_pHasDirectGlyph   = s_noDirectGlyphs;
+    m_pCodePoints       = nullptr;
+    m_pGlyphs           = nullptr;
+}
+
+size_t FontAtlas::GetNumGlyphs() const
+{
+    size_t numDirectGlyphs = NumDirectGlyphs - std::count(m_pHasDirectGlyph, m_pHasDirectGlyph + NumDirectGlyphs, 0);
+
+    return numDirectGlyphs + m_pHeader->numSortedGlyphs;
+}
+
+const GlyphQuad* FontAtlas::FindGlyphSorted(uint32_t codePoint) const
+{
+    const uint32_t* pEnd = m_pCodePoints + m_pHeader->numSortedGlyphs;
+    const uint32_t* it = std::lower_bound(m_pCodePoints, pEnd, codePoint);
+    if (it == pEnd || *it != codePoint)
+        return nullptr;
+
+    return &m_pGlyphs[it - m_pCodePoints];
+}
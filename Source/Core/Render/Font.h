@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+#include "Platform/MappedFile.h"
+
+// Metrics of a multi-channel signed distance field font atlas, as written by msdf-atlas-gen. Plane
+// bounds are in ems relative to the pen position, atlas bounds in texels with the origin at the bottom.
+
+struct Glyph
+{
+    uint32_t    unicode;
+    float       advance;
+
+    float       planeLeft;
+    float       planeBottom;
+    float       planeRight;
+    float       planeTop;
+
+    float       atlasLeft;
+    float       atlasBottom;
+    float       atlasRight;
+    float       atlasTop;
+};
+
+// A glyph as text is laid out with it: plane bounds in ems, texture coordinates normalized to the
+// atlas with v going down, as the texture is sampled
+struct GlyphQuad
+{
+    float       advance;
+
+    float       planeLeft;
+    float       planeBottom;
+    float       planeRight;
+    float       planeTop;
+
+    float       u0;             // Left
+    float       v0;             // Top
+    float       u1;             // Right
+    float       v1;             // Bottom
+};
+
+// A baked font (.font) holds the glyph tables exactly as FontAtlas looks them up, so it is used in place
+// from a memory mapping, without parsing. Little endian, every table 4-byte aligned:
+//   header:        FontFileHeader
+//   direct glyphs: GlyphQuad[256], by code point
+//   direct flags:  uint8_t[256], nonzero where the atlas has the glyph
+//   code points:   uint32_t[numSortedGlyphs], sorted, all outside Latin-1
+//   sorted glyphs: GlyphQuad[numSortedGlyphs], in the order of the code points
+struct FontFileHeader
+{
+    uint32_t    magic;          // "PFNT"
+    uint32_t    version;
+    uint32_t    size;
+    uint32_t    width;
+    uint32_t    height;
+    uint32_t    numSortedGlyphs;
+};
+
+// Collects an atlas' glyphs and bakes them into a font file (see FontBaker)
+class FontAtlasBuilder
+{
+    uint32_t                        m_size;
+    uint32_t                        m_width;
+    uint32_t                        m_height;
+
+    std::map<uint32_t, GlyphQuad>   m_glyphs;
+
+public:
+    // Atlas size in texels, needed to normalize the glyphs' texture coordinates
+    FontAtlasBuilder(uint32_t size, uint32_t width, uint32_t height);
+
+    // Replaces the glyph of the same code point, if any
+    void AddGlyph(const Glyph& glyph);
+
+    std::vector<uint8_t> Bake() const;
+    bool Write(const char* fileName) const;
+};
+
+// The glyphs of a baked font, by code point. Latin-1 (0 - 255, which includes ASCII) is looked up directly
+// in a table; the rest of Unicode is binary searched in a sorted array. Both point into the baked data.
+class FontAtlas
+{
+public:
+    static const uint32_t NumDirectGlyphs = 256;
+
+private:
+    std::unique_ptr<MappedFile> m_pFile;        // Set by Open() with a file name
+    std::vector<uint8_t>        m_data;         // Set by Load()
+
+    const FontFileHeader*       m_pHeader;
+    const GlyphQuad*            m_pDirectGlyphs;
+    const uint8_t*              m_pHasDirectGlyph;
+    const uint32_t*             m_pCodePoints;
+    const GlyphQuad*            m_pGlyphs;
+
+public:
+    // Empty, without any glyphs
+    FontAtlas();
+
+    FontAtlas(FontAtlas&& other);
+    FontAtlas& operator=(FontAtlas&& other);
+
+    // Maps a font file written by FontAtlasBuilder::Write(). False if it is missing or damaged.
+    bool Open(const char* fileName);
+
+    // Uses baked data in place, e.g. from an AssetPack. The data has to outlive the atlas.
+    bool Open(const uint8_t* pData, size_t size);
+
+    // Takes over baked data from FontAtlasBuilder::Bake()
+    bool Load(std::vector<uint8_t>&& bakedData);
+
+    void Close();
+
+    uint32_t GetSize() const { return m_pHeader->size; }
+    uint32_t GetWidth() const { return m_pHeader->width; }
+    uint32_t GetHeight() const { return m_pHeader->height; }
+
+    // Null if the atlas has no glyph for the code point
+    const GlyphQuad* FindGlyph(uint32_t codePoint) const
+    {
+        if (codePoint < NumDirectGlyphs)
+            return m_pHasDirectGlyph[codePoint] ? &m_pDirectGlyphs[codePoint] : nullptr;
+
+        return FindGlyphSorted(codePoint);
+    }
+
+    size_t GetNumGlyphs() const;
+
+private:
+    // Points the tables into the data if it is a valid baked font
+    bool Attach(const uint8_t* pData, size_t size);
+    void Detach();
+
+    const GlyphQuad* FindGlyphSorted(uint32_t codePoint) const;
+};
@@ -0,0 +1,76 @@
+#include "NullRenderBackend.h"
+
+NullRenderBackend::NullRenderBackend(float width, float height)
+{
+    m_width         = width;
+    m_height        = height;
+
+    m_recording     = false;
+
+    m_totalStats    = RenderStats();
+    m_numFrames     = 0;
+}
+
+bool NullRenderBackend::LoadFontAtlasTexture(const uint8_t* /*pData*/, size_t /*size*/)
+{
+    return true;
+}
+
+void NullRenderBackend::BeginFrame(const Float4x4& view, const Float4x4& projection)
+{
+    m_frameStats = RenderStats();
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += sizeof(view) + sizeof(projection);
+
+    Record(RenderCommandType::BeginFrame, RenderPass::Quads, sizeof(view) + sizeof(projection));
+}
+
+void NullRenderBackend::EndFrame()
+{
+    m_totalStats.Add(m_frameStats);
+    ++m_numFrames;
+
+    Record(RenderCommandType::EndFrame, RenderPass::Quads, 0);
+}
+
+void NullRenderBackend::SetPass(RenderPass pass)
+{
+    ++m_frameStats.stateChanges;
+
+    Record(RenderCommandType::SetPass, pass, 0);
+}
+
+void NullRenderBackend::DrawQuadInstances(const QuadInstance* /*pInstances*/, uint32_t count)
+{
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += count * sizeof(QuadInstance);
+
+    ++m_frameStats.draws;
+    m_frameStats.instances += count;
+    m_frameStats.primitives += 2 * count;
+
+    Record(RenderCommandType::DrawQuadInstances, RenderPass::Quads, count * (uint32_t)sizeof(QuadInstance));
+}
+
+void NullRenderBackend::DrawTextQuads(const TextVertex* /*pVertices*/, uint32_t numQuads)
+{
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += numQuads * 4 * sizeof(TextVertex);
+
+    ++m_frameStats.draws;
+    m_frameStats.primitives += 2 * numQuads;
+
+    Record(RenderCommandType::DrawTextQuads, RenderPass::Text, numQuads * 4 * (uint32_t)sizeof(TextVertex));
+}
+
+void NullRenderBackend::Record(RenderCommandType type, RenderPass pass, uint32_t bytes)
+{
+    if (!m_recording)
+        return;
+
+    RenderCommand command;
+    command.type = type;
+    command.pass = pass;
+    command.bytes = bytes;
+    m_commands.push_back(command);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include "RenderBackend.h"
+
+enum class RenderCommandType : uint8_t
+{
+    BeginFrame,
+    EndFrame,
+    SetPass,
+    DrawQuadInstances,
+    DrawTextQuads,
+};
+
+struct RenderCommand
+{
+    RenderCommandType   type;
+    RenderPass          pass;       // SetPass only
+    uint32_t            bytes;      // Uploaded by the command
+};
+
+// A backend without a GPU: every call is counted (see RenderStats) and, optionally, appended to a
+// command list, so the CPU side of rendering can be run, measured and compared on any machine.
+class NullRenderBackend : public RenderBackend
+{
+    float                       m_width;
+    float                       m_height;
+
+    bool                        m_recording;
+    std::vector<RenderCommand>  m_commands;
+
+    RenderStats                 m_totalStats;
+    uint64_t                    m_numFrames;
+
+public:
+    NullRenderBackend(float width = 640.0f, float height = 480.0f);
+
+    // Off by default; the counters are always kept
+    void SetRecording(bool recording) { m_recording = recording; }
+
+    // Everything recorded since the last call to ClearCommands()
+    const std::vector<RenderCommand>& GetCommands() const { return m_commands; }
+    void ClearCommands() { m_commands.clear(); }
+
+    // Sum of all completed frames
+    const RenderStats& GetTotalStats() const { return m_totalStats; }
+    uint64_t GetNumFrames() const { return m_numFrames; }
+
+    float GetWidth() const override { return m_width; }
+    float GetHeight() const override { return m_height; }
+
+    bool LoadFontAtlasTexture(const uint8_t* pData, size_t size) override;
+
+    void BeginFrame(const Float4x4& view, const Float4x4& projection) override;
+    void EndFrame() override;
+
+    void SetPass(RenderPass pass) override;
+    void DrawQuadInstances(const QuadInstance* pInstances, uint32_t count) override;
+    void DrawTextQuads(const TextVertex* pVertices, uint32_t numQuads) override;
+
+private:
+    void Record(RenderCommandType type, RenderPass pass, uint32_t bytes);
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "RenderMath.h"
+
+// The interface between the Renderer and a graphics API. The Renderer decides what to draw (quads for
+// the paddles and the ball, one quad per glyph for text) and batches it; a backend owns the device, the
+// shaders and the buffers and turns these calls into API calls. See D3D11RenderBackend in the game and
+// NullRenderBackend, which only records and counts the calls.
+
+struct QuadVertex
+{
+    Float3      pos;
+};
+
+// One quad of the quad pass: the unit quad scaled, then moved to pos
+struct QuadInstance
+{
+    Float2      pos;
+    Float2      scale;
+};
+
+struct TextVertex
+{
+    Float3      pos;
+    Float2      texCoord;
+};
+
+enum class RenderPass : uint8_t
+{
+    Quads,      // Untextured quads
+    Text,       // Glyphs sampled from the font atlas
+};
+
+// What a backend was asked to do during a frame
+struct RenderStats
+{
+    uint32_t    draws;
+    uint32_t    instances;          // Quads drawn by instanced draws
+    uint32_t    primitives;         // Triangles
+    uint32_t    stateChanges;       // Pipelines bound (shaders, input layout, buffers and textures of a pass)
+    uint32_t    uploads;            // Buffer writes (maps and updates)
+    uint64_t    bytesUploaded;      // Constants, vertices and instances written to the GPU
+
+    void Add(const RenderStats& other)
+    {
+        draws           += other.draws;
+        instances       += other.instances;
+        primitives      += other.primitives;
+        stateChanges    += other.stateChanges;
+        uploads         += other.uploads;
+        bytesUploaded   += other.bytesUploaded;
+    }
+};
+
+class RenderBackend
+{
+protected:
+    RenderStats     m_frameStats;
+
+public:
+    RenderBackend() : m_frameStats() {}
+    virtual ~RenderBackend() {}
+
+    // Size of the render target, in pixels
+    virtual float GetWidth() const = 0;
+    virtual float GetHeight() const = 0;
+
+    // Creates the texture from the contents of a DDS file. Only uses the device, not the immediate
+    // context, so it can run on a worker thread.
+    virtual bool LoadFontAtlasTexture(const uint8_t* pData, size_t size) = 0;
+
+    // Clears the render target and sets the camera for the frame
+    virtual void BeginFrame(const Float4x4& view, const Float4x4& projection) = 0;
+    virtual void EndFrame() = 0;
+
+    // Binds everything the pass draws with
+    virtual void SetPass(RenderPass pass) = 0;
+
+    // Draws the quad pass' quad once per instance: the instances are written to one buffer and drawn
+    // by a single instanced draw
+    virtual void DrawQuadInstances(const QuadInstance* pInstances, uint32_t count) = 0;
+
+    // Draws numQuads text quads of 4 vertices each (in world space, in the order of the quad pass'
+    // quad: top right, top left, bottom right, bottom left) with one vertex buffer upload and one draw
+    virtual void DrawTextQuads(const TextVertex* pVertices, uint32_t numQuads) = 0;
+
+    // Counters of the current frame, reset by BeginFrame()
+    const RenderStats& GetFrameStats() const { return m_frameStats; }
+};
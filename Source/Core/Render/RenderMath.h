@@ -0,0 +1,107 @@
+#pragma once
+
+// Minimal vector and matrix types for the renderer, laid out like DirectXMath's XMFLOAT2/3/4X4 so
+// backends can copy them straight into their buffers. Matrices use the row vector convention
+// (v * M, translation in the last row), as DirectXMath does.
+
+struct Float2
+{
+    float x;
+    float y;
+
+    Float2() : x(0.0f), y(0.0f) {}
+    Float2(float _x, float _y) : x(_x), y(_y) {}
+};
+
+struct Float3
+{
+    float x;
+    float y;
+    float z;
+
+    Float3() : x(0.0f), y(0.0f), z(0.0f) {}
+    Float3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+};
+
+struct Float4x4
+{
+    float m[4][4];
+
+    static Float4x4 Identity()
+    {
+        return Scaling(1.0f, 1.0f);
+    }
+
+    static Float4x4 Scaling(float x, float y)
+    {
+        Float4x4 result = {};
+        result.m[0][0] = x;
+        result.m[1][1] = y;
+        result.m[2][2] = 1.0f;
+        result.m[3][3] = 1.0f;
+        return result;
+    }
+
+    static Float4x4 Translation(const Float2& offset)
+    {
+        return ScalingTranslation(Float2(1.0f, 1.0f), offset);
+    }
+
+    // Same as XMMatrixScaling * XMMatrixTranslation
+    static Float4x4 ScalingTranslation(const Float2& scale, const Float2& offset)
+    {
+        Float4x4 result = Scaling(scale.x, scale.y);
+        result.m[3][0] = offset.x;
+        result.m[3][1] = offset.y;
+        return result;
+    }
+
+    // Same as XMMatrixOrthographicOffCenterLH
+    static Float4x4 OrthographicOffCenter(float left, float right, float bottom, float top, float nearZ, float farZ)
+    {
+        Float4x4 result = {};
+        result.m[0][0] = 2.0f / (right - left);
+        result.m[1][1] = 2.0f / (top - bottom);
+        result.m[2][2] = 1.0f / (farZ - nearZ);
+        result.m[3][0] = (left + right) / (left - right);
+        result.m[3][1] = (top + bottom) / (bottom - top);
+        result.m[3][2] = nearZ / (nearZ - farZ);
+        result.m[3][3] = 1.0f;
+        return result;
+    }
+
+    // Where the point (x, y, 0, 1) ends up, divided by w
+    Float2 TransformPoint(const Float2& point) const
+    {
+        float x = point.x * m[0][0] + point.y * m[1][0] + m[3][0];
+        float y = point.x * m[0][1] + point.y * m[1][1] + m[3][1];
+        float w = point.x * m[0][3] + point.y * m[1][3] + m[3][3];
+        return Float2(x / w, y / w);
+    }
+
+    Float4x4 Transposed() const
+    {
+        Float4x4 result;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+                result.m[row][column] = m[column][row];
+        }
+        return result;
+    }
+};
+
+// Applies a, then b (row vectors)
+inline Float4x4 operator*(const Float4x4& a, const Float4x4& b)
+{
+    Float4x4 result;
+    for (int row = 0; row < 4; ++row)
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            result.m[row][column] = a.m[row][0] * b.m[0][column] + a.m[row][1] * b.m[1][column] +
+                a.m[row][2] * b.m[2][column] + a.m[row][3] * b.m[3][column];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cassert>
+#include "Renderer.h"
+
+Renderer::Renderer()
+{
+    m_pBackend              = nullptr;
+    m_fontAtlasVersion      = 1;
+
+    m_timings               = RenderTimings();
+}
+
+void Renderer::Initialize(RenderBackend* pBackend)
+{
+    m_pBackend = pBackend;
+}
+
+void Renderer::Uninitialize()
+{
+    m_pBackend = nullptr;
+    m_quadBatch.clear();
+    m_textBatch.clear();
+}
+
+void Renderer::PreRender()
+{
+    m_frameStart = std::chrono::steady_clock::now();
+
+    Float4x4 projection = Float4x4::OrthographicOffCenter(0.0f, m_pBackend->GetWidth(), 0.0f, m_pBackend->GetHeight(), -1.0f, 1.0f);
+
+    m_pBackend->BeginFrame(Float4x4::Identity(), projection);
+}
+
+void Renderer::PostRender()
+{
+    Flush();
+
+    std::chrono::steady_clock::time_point submitted = std::chrono::steady_clock::now();
+
+    m_pBackend->EndFrame();
+
+    std::chrono::steady_clock::time_point finished = std::chrono::steady_clock::now();
+
+    m_timings.lastSubmitSeconds     = std::chrono::duration<double>(submitted - m_frameStart).count();
+    m_timings.lastFrameSeconds      = std::chrono::duration<double>(finished - m_frameStart).count();
+    m_timings.totalSubmitSeconds    += m_timings.lastSubmitSeconds;
+    m_timings.totalFrameSeconds     += m_timings.lastFrameSeconds;
+    m_timings.maxFrameSeconds       = std::max(m_timings.maxFrameSeconds, m_timings.lastFrameSeconds);
+    ++m_timings.frames;
+}
+
+void Renderer::PrepareQuadPass()
+{
+    Flush();
+
+    m_pBackend->SetPass(RenderPass::Quads);
+}
+
+void Renderer::PrepareTextPass()
+{
+    Flush();
+
+    m_pBackend->SetPass(RenderPass::Text);
+}
+
+void Renderer::RenderQuad(const Float2& pos, const Float2& scale)
+{
+    m_quadBatch.push_back({ pos, scale });
+}
+
+void Renderer::RenderQuads(const QuadInstance* pInstances, size_t count)
+{
+    m_quadBatch.insert(m_quadBatch.end(), pInstances, pInstances + count);
+}
+
+// The code point starting at text[i], advancing i past it. Malformed sequences decode to U+FFFD.
+static uint32_t DecodeUtf8(const char* text, size_t length, size_t& i)
+{
+    uint8_t lead = (uint8_t)text[i++];
+    if (lead < 0x80)
+        return lead;
+
+    size_t numContinuations;
+    uint32_t codePoint;
+    if ((lead & 0xe0) == 0xc0)
+    {
+        numContinuations = 1;
+        codePoint = lead & 0x1f;
+    }
+    else if ((lead & 0xf0) == 0xe0)
+    {
+        numContinuations = 2;
+        codePoint = lead & 0x0f;
+    }
+    else if ((lead & 0xf8) == 0xf0)
+    {
+        numContinuations = 3;
+        codePoint = lead & 0x07;
+    }
+    else
+    {
+        return 0xfffd;
+    }
+
+    for (size_t n = 0; n < numContinuations; ++n)
+    {
+        if (i >= length || ((uint8_t)text[i] & 0xc0) != 0x80)
+            return 0xfffd;
+
+        codePoint = (codePoint << 6) | ((uint8_t)text[i++] & 0x3f);
+    }
+
+    return codePoint;
+}
+
+void Renderer::RenderText(const std::string& str, const Float2& pos, float size)
+{
+    LayoutText(str.data(), str.size(), pos, size, m_textBatch);
+}
+
+bool Renderer::UpdateTextRun(TextRun& run, const char* text, const Float2& pos, float size) const
+{
+    if (run.m_fontAtlasVersion == m_fontAtlasVersion && run.m_pos.x == pos.x && run.m_pos.y == pos.y && run.m_size == size &&
+        run.m_text == text)
+    {
+        return false;
+    }
+
+    run.m_text = text;
+    run.m_pos = pos;
+    run.m_size = size;
+    run.m_fontAtlasVersion = m_fontAtlasVersion;
+
+    run.m_vertices.clear();
+    LayoutText(run.m_text.data(), run.m_text.size(), pos, size, run.m_vertices);
+    ++run.m_numLayouts;
+
+    return true;
+}
+
+void Renderer::RenderTextRun(const TextRun& run)
+{
+    m_textBatch.insert(m_textBatch.end(), run.m_vertices.begin(), run.m_vertices.end());
+}
+
+void Renderer::LayoutText(const char* text, size_t length, const Float2& pos, float size, std::vector<TextVertex>& outVertices) const
+{
+    // Room for every byte being a glyph, trimmed to the glyphs found at the end
+    size_t first = outVertices.size();
+    outVertices.resize(first + length * 4);
+    TextVertex* pVertices = outVertices.data() + first;
+
+    float offset = pos.x;
+
+    for (size_t i = 0; i < length;)
+    {
+        const GlyphQuad* pGlyph = m_fontAtlas.FindGlyph(DecodeUtf8(text, length, i));
+        if (pGlyph == nullptr)
+            continue;
+
+        float left = pGlyph->planeLeft * size + offset;
+        float right = pGlyph->planeRight * size + offset;
+        float top = pGlyph->planeTop * size + pos.y;
+        float bottom = pGlyph->planeBottom * size + pos.y;
+
+        pVertices[0] = { Float3(right, top,    0.0f), Float2(pGlyph->u1, pGlyph->v0) };
+        pVertices[1] = { Float3(left,  top,    0.0f), Float2(pGlyph->u0, pGlyph->v0) };
+        pVertices[2] = { Float3(right, bottom, 0.0f), Float2(pGlyph->u1, pGlyph->v1) };
+        pVertices[3] = { Float3(left,  bottom, 0.0f), Float2(pGlyph->u0, pGlyph->v1) };
+        pVertices += 4;
+
+        offset += pGlyph->advance * size;
+    }
+
+    outVertices.resize(pVertices - outVertices.data());
+}
+
+void Renderer::Flush()
+{
+    if (!m_quadBatch.empty())
+    {
+        m_pBackend->DrawQuadInstances(m_quadBatch.data(), (uint32_t)m_quadBatch.size());
+        m_quadBatch.clear();
+    }
+
+    if (!m_textBatch.empty())
+    {
+        m_pBackend->DrawTextQuads(m_textBatch.data(), (uint32_t)(m_textBatch.size() / 4));
+        m_textBatch.clear();
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Font.h"
+#include "RenderBackend.h"
+#include "TextRun.h"
+
+// CPU time of the frames drawn so far. Submission is PreRender() up to the backend's EndFrame(), which is
+// where the Renderer's own work is; the frame adds EndFrame() (presenting, or rasterizing in software).
+struct RenderTimings
+{
+    uint64_t    frames;
+    double      lastSubmitSeconds;
+    double      lastFrameSeconds;
+    double      totalSubmitSeconds;
+    double      totalFrameSeconds;
+    double      maxFrameSeconds;
+};
+
+// Draws the game: quads for the paddles and the ball, and text from a font atlas. What is drawn is
+// decided here; how it is drawn is up to the RenderBackend, so the same code runs on D3D11 or headless.
+class Renderer
+{
+    RenderBackend*  m_pBackend;
+    FontAtlas       m_fontAtlas;
+    uint32_t        m_fontAtlasVersion;         // Changed by SetFontAtlas(), so text runs are laid out again
+
+    std::vector<QuadInstance> m_quadBatch;     // Quads of the current quad pass, drawn when it ends
+    std::vector<TextVertex> m_textBatch;        // Glyph quads of the current text pass, 4 vertices each
+
+    std::chrono::steady_clock::time_point m_frameStart;
+    RenderTimings   m_timings;
+
+public:
+    Renderer();
+
+    // The backend is not owned and must outlive the renderer's use of it
+    void Initialize(RenderBackend* pBackend);
+    void Uninitialize();
+
+    RenderBackend* GetBackend() const { return m_pBackend; }
+
+    void SetFontAtlas(FontAtlas&& fontAtlas) { m_fontAtlas = std::move(fontAtlas); ++m_fontAtlasVersion; }
+    const FontAtlas& GetFontAtlas() const { return m_fontAtlas; }
+
+    void PreRender();
+    void PostRender();
+    
+    void PrepareQuadPass();
+    void PrepareTextPass();
+
+    // Everything is batched: all quads of a pass are drawn together by one instanced draw, and all glyphs
+    // of a pass by one draw, when the pass ends (at the next Prepare*Pass() or PostRender())
+    void RenderQuad(const Float2& pos, const Float2& scale);
+    void RenderQuads(const QuadInstance* pInstances, size_t count);
+    // UTF-8; characters without a glyph in the atlas are skipped
+    void RenderText(const std::string& str, const Float2& pos, float size);
+
+    // For text drawn on many frames: the run keeps its layout until one of its arguments changes. Returns
+    // whether it was laid out again.
+    bool UpdateTextRun(TextRun& run, const char* text, const Float2& pos, float size) const;
+    void RenderTextRun(const TextRun& run);
+
+    const RenderTimings& GetTimings() const { return m_timings; }
+    void ResetTimings() { m_timings = RenderTimings(); }
+
+private:
+    // Appends 4 vertices per glyph of the UTF-8 text
+    void LayoutText(const char* text, size_t length, const Float2& pos, float size, std::vector<TextVertex>& outVertices) const;
+
+    // Submits the batches of the pass that is ending
+    void Flush();
+};
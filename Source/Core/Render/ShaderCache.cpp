@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <cstring>
+#include "ShaderCache.h"
+#include "Platform/File.h"
+#include "Platform/Hash.h"
+#include "Platform/MappedFile.h"
+
+static const uint32_t ShaderCacheMagic = 0x43485350; // "PSHC"
+static const uint32_t ShaderCacheVersion = 1;
+
+struct ShaderCacheHeader
+{
+    uint32_t    magic;
+    uint32_t    version;
+    uint64_t    key;
+    uint32_t    bytecodeSize;
+    uint32_t    reserved;
+};
+
+static_assert(sizeof(ShaderCacheHeader) == 24, "ShaderCacheHeader is stored as is in cache files");
+
+uint64_t ComputeShaderKey(const void* pSource, size_t sourceSize, const char* entryPoint, const char* profile, uint32_t compileFlags)
+{
+    // The terminating zeros keep e.g. "VSMain" + "vs_4_0" apart from "VSMainv" + "s_4_0"
+    uint64_t hash = HashFnv1a(pSource, sourceSize);
+    hash = HashFnv1a(entryPoint, strlen(entryPoint) + 1, hash);
+    hash = HashFnv1a(profile, strlen(profile) + 1, hash);
+    hash = HashFnv1a(&compileFlags, sizeof(compileFlags), hash);
+
+    return hash;
+}
+
+std::string GetShaderCacheFileName(const char* sourceFileName, const char* entryPoint)
+{
+    std::string fileName = sourceFileName;
+
+    size_t extension = fileName.find_last_of('.');
+    size_t directory = fileName.find_last_of("/\\");
+    if (extension != std::string::npos && (directory == std::string::npos || extension > directory))
+        fileName.resize(extension);
+
+    return fileName + "." + entryPoint + ".shadercache";
+}
+
+bool ReadShaderCache(const char* fileName, uint64_t key, std::vector<uint8_t>& outBytecode)
+{
+    MappedFile file;
+    if (!file.Open(fileName) || file.GetSize() < sizeof(ShaderCacheHeader))
+        return false;
+
+    ShaderCacheHeader header;
+    memcpy(&header, file.GetData(), sizeof(header));
+    if (header.magic != ShaderCacheMagic || header.version != ShaderCacheVersion || header.key != key)
+        return false;
+
+    if (header.bytecodeSize == 0 || header.bytecodeSize != file.GetSize() - sizeof(header))
+        return false;
+
+    const uint8_t* pBytecode = file.GetData() + sizeof(header);
+    outBytecode.assign(pBytecode, pBytecode + header.bytecodeSize);
+
+    return true;
+}
+
+bool WriteShaderCache(const char* fileName, uint64_t key, const void* pBytecode, size_t bytecodeSize)
+{
+    if (bytecodeSize == 0 || bytecodeSize > UINT32_MAX)
+        return false;
+
+    FILE* pFile = OpenStdioFile(fileName, "wb");
+    if (pFile == nullptr)
+        return false;
+
+    ShaderCacheHeader header;
+    header.magic = ShaderCacheMagic;
+    header.version = ShaderCacheVersion;
+    header.key = key;
+    header.bytecodeSize = (uint32_t)bytecodeSize;
+    header.reserved = 0;
+
+    bool written = fwrite(&header, sizeof(header), 1, pFile) == 1 && fwrite(pBytecode, bytecodeSize, 1, pFile) == 1;
+    written = (fclose(pFile) == 0) && written;
+
+    // Don't leave a truncated file behind; it would be rejected anyway, but only after being read
+    if (!written)
+        remove(fileName);
+
+    return written;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Compiled shaders are cached in files of their own, so starting the game doesn't wait for the HLSL
+// compiler. A cache file holds the bytecode of one entry point behind a header with a key: a 64-bit
+// FNV-1a hash of the source text, the entry point, the target profile and the compile flags. Reading
+// checks the key, so a cache file is only used for exactly what it was compiled from, and an edited
+// shader is compiled again. The shaders have no #includes, so the source text is all there is to hash.
+//
+// File layout (little endian):
+//   header:    magic "PSHC", version (u32), key (u64), bytecode size (u32), reserved (u32)
+//   bytecode
+
+uint64_t ComputeShaderKey(const void* pSource, size_t sourceSize, const char* entryPoint, const char* profile, uint32_t compileFlags);
+
+// "Data/Shader.hlsl" and "VSMain" give "Data/Shader.VSMain.shadercache"
+std::string GetShaderCacheFileName(const char* sourceFileName, const char* entryPoint);
+
+// False if the file is missing, damaged or has a different key
+bool ReadShaderCache(const char* fileName, uint64_t key, std::vector<uint8_t>& outBytecode);
+bool WriteShaderCache(const char* fileName, uint64_t key, const void* pBytecode, size_t bytecodeSize);
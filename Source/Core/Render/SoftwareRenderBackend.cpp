@@ -0,0 +1,409 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "SoftwareRenderBackend.h"
+#include "Platform/File.h"
+#include "Threading/JobSystem.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PONG_SIMD_X86 1
+#include <emmintrin.h>
+#endif
+
+static void FillSpan(uint32_t* pPixels, int count, uint32_t color)
+{
+    int i = 0;
+
+#ifdef PONG_SIMD_X86
+    const __m128i colors = _mm_set1_epi32((int)color);
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm_storeu_si128((__m128i*)(pPixels + i), colors);
+        _mm_storeu_si128((__m128i*)(pPixels + i + 4), colors);
+    }
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128((__m128i*)(pPixels + i), colors);
+#endif
+
+    for (; i < count; ++i)
+        pPixels[i] = color;
+}
+
+static int WrapTexel(int texel, int size)
+{
+    while (texel < 0)
+        texel += size;
+    while (texel >= size)
+        texel -= size;
+
+    return texel;
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend(uint32_t width, uint32_t height, JobSystem* pJobs)
+{
+    m_width             = width;
+    m_height            = height;
+    m_pJobs             = pJobs;
+
+    m_pixels.assign((size_t)width * height, ClearColor);
+
+    m_fontWidth         = 0;
+    m_fontHeight        = 0;
+
+    m_viewProjection    = Float4x4::Identity();
+
+    m_numTilesX         = (width + TileSize - 1) / TileSize;
+    m_numTilesY         = (height + TileSize - 1) / TileSize;
+    m_tileDrawOffsets.resize(m_numTilesX * m_numTilesY + 1);
+}
+
+void SoftwareRenderBackend::SetFontAtlasTexture(const uint8_t* pTexels, uint32_t width, uint32_t height, uint32_t bytesPerTexel)
+{
+    m_fontWidth = width;
+    m_fontHeight = height;
+    m_fontTexels.resize((size_t)width * height);
+
+    for (size_t i = 0; i < m_fontTexels.size(); ++i)
+        m_fontTexels[i] = pTexels[i * bytesPerTexel];
+}
+
+bool SoftwareRenderBackend::LoadFontAtlasTexture(const uint8_t* pData, size_t size)
+{
+    // DDS_HEADER: height at 12, width at 16, pixel format flags at 80, four CC at 84, bits per pixel at 88
+    // and the red mask at 92. Data follows at 128, or at 148 after a DX10 header.
+    if (pData == nullptr || size < 128 || memcmp(pData, "DDS ", 4) != 0)
+        return false;
+
+    auto read32 = [pData](size_t offset) { uint32_t value; memcpy(&value, pData + offset, sizeof(value)); return value; };
+
+    const uint32_t DDPF_FOURCC = 0x4;
+    uint32_t height = read32(12);
+    uint32_t width = read32(16);
+    uint32_t formatFlags = read32(80);
+    uint32_t bitsPerTexel = read32(88);
+    uint32_t redMask = read32(92);
+    size_t dataOffset = 128;
+
+    if (formatFlags & DDPF_FOURCC)
+    {
+        // Only DX10 headers with R8_UNORM (61) or R8G8B8A8_UNORM (28)
+        if (memcmp(pData + 84, "DX10", 4) != 0 || size < 148)
+            return false;
+
+        uint32_t dxgiFormat = read32(128);
+        if (dxgiFormat != 61 && dxgiFormat != 28)
+            return false;
+
+        bitsPerTexel = (dxgiFormat == 61) ? 8 : 32;
+        redMask = 0xff;
+        dataOffset = 148;
+    }
+
+    if (bitsPerTexel != 8 && bitsPerTexel != 32)
+        return false;
+
+    uint32_t bytesPerTexel = bitsPerTexel / 8;
+    uint32_t redOffset = 0;
+    if (bytesPerTexel == 4)
+    {
+        while (redOffset < 3 && (redMask >> (redOffset * 8) & 0xff) == 0)
+            ++redOffset;
+    }
+
+    if (width == 0 || height == 0 || (size - dataOffset) / bytesPerTexel / width < height)
+        return false;
+
+    SetFontAtlasTexture(pData + dataOffset + redOffset, width, height, bytesPerTexel);
+
+    return true;
+}
+
+bool SoftwareRenderBackend::SaveTga(const char* fileName) const
+{
+    FILE* pFile = OpenStdioFile(fileName, "wb");
+    if (pFile == nullptr)
+        return false;
+
+    // Uncompressed true color, 8 alpha bits, top-left origin
+    uint8_t header[18] = {};
+    header[2] = 2;
+    header[12] = (uint8_t)m_width;
+    header[13] = (uint8_t)(m_width >> 8);
+    header[14] = (uint8_t)m_height;
+    header[15] = (uint8_t)(m_height >> 8);
+    header[16] = 32;
+    header[17] = 0x28;
+    bool written = fwrite(header, sizeof(header), 1, pFile) == 1;
+
+    std::vector<uint8_t> row(m_width * 4);
+    for (uint32_t y = 0; y < m_height && written; ++y)
+    {
+        // RGBA to BGRA
+        const uint32_t* pRow = &m_pixels[(size_t)y * m_width];
+        for (uint32_t x = 0; x < m_width; ++x)
+        {
+            row[x * 4 + 0] = (uint8_t)(pRow[x] >> 16);
+            row[x * 4 + 1] = (uint8_t)(pRow[x] >> 8);
+            row[x * 4 + 2] = (uint8_t)pRow[x];
+            row[x * 4 + 3] = (uint8_t)(pRow[x] >> 24);
+        }
+
+        written = fwrite(row.data(), row.size(), 1, pFile) == 1;
+    }
+
+    return (fclose(pFile) == 0) && written;
+}
+
+void SoftwareRenderBackend::BeginFrame(const Float4x4& view, const Float4x4& projection)
+{
+    m_frameStats = RenderStats();
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += sizeof(view) + sizeof(projection);
+
+    m_viewProjection = view * projection;
+    m_draws.clear();
+}
+
+void SoftwareRenderBackend::EndFrame()
+{
+    BinDraws();
+
+    uint32_t numTiles = m_numTilesX * m_numTilesY;
+    if (m_pJobs != nullptr)
+    {
+        m_pJobs->ParallelFor(numTiles, 1, [this](size_t begin, size_t end)
+        {
+            for (size_t tile = begin; tile < end; ++tile)
+                RasterizeTile((uint32_t)tile);
+        });
+    }
+    else
+    {
+        for (uint32_t tile = 0; tile < numTiles; ++tile)
+            RasterizeTile(tile);
+    }
+}
+
+void SoftwareRenderBackend::SetPass(RenderPass /*pass*/)
+{
+    ++m_frameStats.stateChanges;
+}
+
+void SoftwareRenderBackend::DrawQuadInstances(const QuadInstance* pInstances, uint32_t count)
+{
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += count * sizeof(QuadInstance);
+
+    ++m_frameStats.draws;
+    m_frameStats.instances += count;
+    m_frameStats.primitives += 2 * count;
+
+    Float2 texCoord;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const QuadInstance& instance = pInstances[i];
+        Float2 halfScale(instance.scale.x * 0.5f, instance.scale.y * 0.5f);
+        Float2 corner0(instance.pos.x + halfScale.x, instance.pos.y + halfScale.y);
+        Float2 corner3(instance.pos.x - halfScale.x, instance.pos.y - halfScale.y);
+
+        AddDraw(RenderPass::Quads, corner0, corner3, texCoord, texCoord);
+    }
+}
+
+void SoftwareRenderBackend::DrawTextQuads(const TextVertex* pVertices, uint32_t numQuads)
+{
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += numQuads * 4 * sizeof(TextVertex);
+
+    ++m_frameStats.draws;
+    m_frameStats.primitives += 2 * numQuads;
+
+    // Opposite corners of every quad (top right and bottom left), with their texture coordinates
+    for (uint32_t i = 0; i < numQuads; ++i)
+    {
+        const TextVertex& vertex0 = pVertices[i * 4];
+        const TextVertex& vertex3 = pVertices[i * 4 + 3];
+
+        AddDraw(RenderPass::Text, Float2(vertex0.pos.x, vertex0.pos.y), Float2(vertex3.pos.x, vertex3.pos.y),
+            vertex0.texCoord, vertex3.texCoord);
+    }
+}
+
+void SoftwareRenderBackend::AddDraw(RenderPass pass, const Float2& corner0, const Float2& corner3, const Float2& texCoord0, const Float2& texCoord3)
+{
+    // To pixels, with y going down
+    Float2 screen0 = m_viewProjection.TransformPoint(corner0);
+    Float2 screen3 = m_viewProjection.TransformPoint(corner3);
+    screen0 = Float2((screen0.x + 1.0f) * 0.5f * m_width, (1.0f - screen0.y) * 0.5f * m_height);
+    screen3 = Float2((screen3.x + 1.0f) * 0.5f * m_width, (1.0f - screen3.y) * 0.5f * m_height);
+
+    if (screen0.x == screen3.x || screen0.y == screen3.y)
+        return;
+
+    // Pixels whose centers are inside, with the top-left rule
+    Draw draw;
+    draw.minX = std::max((int)ceilf(std::min(screen0.x, screen3.x) - 0.5f), 0);
+    draw.minY = std::max((int)ceilf(std::min(screen0.y, screen3.y) - 0.5f), 0);
+    draw.maxX = std::min((int)ceilf(std::max(screen0.x, screen3.x) - 0.5f), (int)m_width);
+    draw.maxY = std::min((int)ceilf(std::max(screen0.y, screen3.y) - 0.5f), (int)m_height);
+    if (draw.minX >= draw.maxX || draw.minY >= draw.maxY)
+        return;
+
+    draw.pass = pass;
+    draw.uPerPixel = (texCoord3.x - texCoord0.x) / (screen3.x - screen0.x);
+    draw.vPerPixel = (texCoord3.y - texCoord0.y) / (screen3.y - screen0.y);
+    draw.u = texCoord0.x + ((float)draw.minX + 0.5f - screen0.x) * draw.uPerPixel;
+    draw.v = texCoord0.y + ((float)draw.minY + 0.5f - screen0.y) * draw.vPerPixel;
+
+    m_draws.push_back(draw);
+}
+
+void SoftwareRenderBackend::BinDraws()
+{
+    // Count the draws of every tile, turn the counts into offsets, then fill in the draw indices in submission order
+    std::fill(m_tileDrawOffsets.begin(), m_tileDrawOffsets.end(), 0);
+
+    for (const Draw& draw : m_draws)
+    {
+        for (int tileY = draw.minY / (int)TileSize; tileY <= (draw.maxY - 1) / (int)TileSize; ++tileY)
+        {
+            for (int tileX = draw.minX / (int)TileSize; tileX <= (draw.maxX - 1) / (int)TileSize; ++tileX)
+                ++m_tileDrawOffsets[tileY * m_numTilesX + tileX + 1];
+        }
+    }
+
+    for (size_t tile = 1; tile < m_tileDrawOffsets.size(); ++tile)
+        m_tileDrawOffsets[tile] += m_tileDrawOffsets[tile - 1];
+
+    m_tileDraws.resize(m_tileDrawOffsets.back());
+
+    std::vector<uint32_t>& next = m_tileDrawOffsets;
+    for (uint32_t d = 0; d < (uint32_t)m_draws.size(); ++d)
+    {
+        const Draw& draw = m_draws[d];
+        for (int tileY = draw.minY / (int)TileSize; tileY <= (draw.maxY - 1) / (int)TileSize; ++tileY)
+        {
+            for (int tileX = draw.minX / (int)TileSize; tileX <= (draw.maxX - 1) / (int)TileSize; ++tileX)
+                m_tileDraws[next[tileY * m_numTilesX + tileX]++] = d;
+        }
+    }
+
+    // Filling in moved every offset to the start of the next tile
+    for (size_t tile = m_tileDrawOffsets.size() - 1; tile > 0; --tile)
+        m_tileDrawOffsets[tile] = m_tileDrawOffsets[tile - 1];
+    m_tileDrawOffsets[0] = 0;
+}
+
+void SoftwareRenderBackend::RasterizeTile(uint32_t tile)
+{
+    const int tileMinX = (int)((tile % m_numTilesX) * TileSize);
+    const int tileMinY = (int)((tile / m_numTilesX) * TileSize);
+    const int tileMaxX = std::min(tileMinX + (int)TileSize, (int)m_width);
+    const int tileMaxY = std::min(tileMinY + (int)TileSize, (int)m_height);
+
+    for (int y = tileMinY; y < tileMaxY; ++y)
+        FillSpan(&m_pixels[(size_t)y * m_width + tileMinX], tileMaxX - tileMinX, ClearColor);
+
+    for (uint32_t i = m_tileDrawOffsets[tile]; i < m_tileDrawOffsets[tile + 1]; ++i)
+    {
+        const Draw& draw = m_draws[m_tileDraws[i]];
+        int minX = std::max(draw.minX, tileMinX);
+        int maxX = std::min(draw.maxX, tileMaxX);
+        int minY = std::max(draw.minY, tileMinY);
+        int maxY = std::min(draw.maxY, tileMaxY);
+
+        for (int y = minY; y < maxY; ++y)
+        {
+            uint32_t* pRow = &m_pixels[(size_t)y * m_width];
+            if (draw.pass == RenderPass::Quads)
+                FillSpan(pRow + minX, maxX - minX, QuadColor);
+            else if (!m_fontTexels.empty())
+                DrawTextSpan(pRow, minX, maxX, draw, y);
+        }
+    }
+}
+
+void SoftwareRenderBackend::DrawTextSpan(uint32_t* pRow, int minX, int maxX, const Draw& draw, int y) const
+{
+    // Texture coordinates only change along x within a row, so the two texel rows and their weight are fixed
+    const int fontWidth = (int)m_fontWidth;
+    const int fontHeight = (int)m_fontHeight;
+
+    float texelY = (draw.v + (float)(y - draw.minY) * draw.vPerPixel) * fontHeight - 0.5f;
+    float floorY = floorf(texelY);
+    float weightY = texelY - floorY;
+    const uint8_t* pTexels0 = &m_fontTexels[(size_t)WrapTexel((int)floorY, fontHeight) * fontWidth];
+    const uint8_t* pTexels1 = &m_fontTexels[(size_t)WrapTexel((int)floorY + 1, fontHeight) * fontWidth];
+
+    const float texelsPerPixel = draw.uPerPixel * fontWidth;
+    const float texelX0 = (draw.u + (float)(minX - draw.minX) * draw.uPerPixel) * fontWidth - 0.5f;
+
+    int x = minX;
+
+#ifdef PONG_SIMD_X86
+    const __m128 steps = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+    const __m128 weightYs = _mm_set1_ps(weightY);
+
+    for (; x + 4 <= maxX; x += 4)
+    {
+        __m128 texelX = _mm_add_ps(_mm_set1_ps(texelX0 + (float)(x - minX) * texelsPerPixel), _mm_mul_ps(steps, _mm_set1_ps(texelsPerPixel)));
+
+        // floor(): truncate, then step down where that rounded a negative value up
+        __m128i floorX = _mm_cvttps_epi32(texelX);
+        floorX = _mm_add_epi32(floorX, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(floorX), texelX)));
+        __m128 weightX = _mm_sub_ps(texelX, _mm_cvtepi32_ps(floorX));
+
+        alignas(16) int32_t columns[4];
+        _mm_store_si128((__m128i*)columns, floorX);
+
+        alignas(16) float t00[4], t01[4], t10[4], t11[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            int column0 = WrapTexel(columns[i], fontWidth);
+            int column1 = WrapTexel(columns[i] + 1, fontWidth);
+            t00[i] = pTexels0[column0];
+            t01[i] = pTexels0[column1];
+            t10[i] = pTexels1[column0];
+            t11[i] = pTexels1[column1];
+        }
+
+        __m128 top = _mm_add_ps(_mm_load_ps(t00), _mm_mul_ps(_mm_sub_ps(_mm_load_ps(t01), _mm_load_ps(t00)), weightX));
+        __m128 bottom = _mm_add_ps(_mm_load_ps(t10), _mm_mul_ps(_mm_sub_ps(_mm_load_ps(t11), _mm_load_ps(t10)), weightX));
+        __m128 alpha = _mm_mul_ps(_mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), weightYs)), scale);
+
+        __m128i covered = _mm_castps_si128(_mm_cmpge_ps(alpha, half));
+        if (_mm_movemask_epi8(covered) == 0)
+            continue;
+
+        // The shader returns alpha in every channel
+        __m128i value = _mm_cvtps_epi32(_mm_mul_ps(alpha, _mm_set1_ps(255.0f)));
+        value = _mm_or_si128(value, _mm_slli_epi32(value, 8));
+        value = _mm_or_si128(value, _mm_slli_epi32(value, 16));
+
+        __m128i previous = _mm_loadu_si128((const __m128i*)(pRow + x));
+        __m128i result = _mm_or_si128(_mm_and_si128(covered, value), _mm_andnot_si128(covered, previous));
+        _mm_storeu_si128((__m128i*)(pRow + x), result);
+    }
+#endif
+
+    for (; x < maxX; ++x)
+    {
+        float texelX = texelX0 + (float)(x - minX) * texelsPerPixel;
+        float floorX = floorf(texelX);
+        float weightX = texelX - floorX;
+        int column0 = WrapTexel((int)floorX, fontWidth);
+        int column1 = WrapTexel((int)floorX + 1, fontWidth);
+
+        float top = pTexels0[column0] + (pTexels0[column1] - pTexels0[column0]) * weightX;
+        float bottom = pTexels1[column0] + (pTexels1[column1] - pTexels1[column0]) * weightX;
+        float alpha = (top + (bottom - top) * weightY) * (1.0f / 255.0f);
+        if (alpha < 0.5f)
+            continue;
+
+        uint32_t value = (uint32_t)lrintf(alpha * 255.0f);
+        pRow[x] = value | (value << 8) | (value << 16) | (value << 24);
+    }
+}
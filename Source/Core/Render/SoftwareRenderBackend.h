@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "RenderBackend.h"
+
+class JobSystem;
+
+// Renders into an RGBA8 framebuffer on the CPU, for frames on machines without a GPU (thumbnails,
+// spectating, reference images). It draws what the game's shaders do: the quad pass in plain white
+// (Shader.hlsl) and the text pass from the red channel of the font atlas, bilinearly filtered with
+// wrapping and discarded below 0.5 (TextShader.hlsl).
+//
+// Draws are only collected during the frame. EndFrame() bins them into screen tiles and rasterizes
+// the tiles in parallel on the job system (if one is given), filling spans 4 pixels at a time with SSE2.
+// Quads are drawn as screen aligned rectangles, which is all the Renderer submits: rotations are not
+// supported.
+class SoftwareRenderBackend : public RenderBackend
+{
+public:
+    static const uint32_t TileSize = 64;
+
+    // Pixels are R, G, B, A from the lowest byte up
+    static const uint32_t ClearColor = 0xff000000;
+    static const uint32_t QuadColor = 0xffffffff;
+
+private:
+    struct Draw
+    {
+        int         minX;           // Covered pixels [minX, maxX) x [minY, maxY)
+        int         minY;
+        int         maxX;
+        int         maxY;
+        RenderPass  pass;
+        float       u;              // Texture coordinates at the center of pixel (minX, minY)
+        float       v;
+        float       uPerPixel;
+        float       vPerPixel;
+    };
+
+    uint32_t                m_width;
+    uint32_t                m_height;
+    JobSystem*              m_pJobs;
+
+    std::vector<uint32_t>   m_pixels;
+
+    std::vector<uint8_t>    m_fontTexels;       // Red channel only
+    uint32_t                m_fontWidth;
+    uint32_t                m_fontHeight;
+
+    Float4x4                m_viewProjection;
+
+    std::vector<Draw>       m_draws;
+    uint32_t                m_numTilesX;
+    uint32_t                m_numTilesY;
+    std::vector<uint32_t>   m_tileDrawOffsets;  // Tile t's draws are m_tileDraws[m_tileDrawOffsets[t], m_tileDrawOffsets[t + 1])
+    std::vector<uint32_t>   m_tileDraws;
+
+public:
+    // Without a job system the tiles are rasterized on the calling thread
+    SoftwareRenderBackend(uint32_t width = 640, uint32_t height = 480, JobSystem* pJobs = nullptr);
+
+    // The finished frame after EndFrame(), row 0 at the top, GetWidth() pixels per row
+    const uint32_t* GetPixels() const { return m_pixels.data(); }
+
+    // Font atlas texels, for callers that don't load it from a file. Only the first byte of every
+    // bytesPerTexel is used.
+    void SetFontAtlasTexture(const uint8_t* pTexels, uint32_t width, uint32_t height, uint32_t bytesPerTexel);
+
+    // Writes the last frame as an uncompressed 32 bit TGA
+    bool SaveTga(const char* fileName) const;
+
+    float GetWidth() const override { return (float)m_width; }
+    float GetHeight() const override { return (float)m_height; }
+
+    // Uncompressed DDS files with 8 (luminance or R8) or 32 bits per texel
+    bool LoadFontAtlasTexture(const uint8_t* pData, size_t size) override;
+
+    void BeginFrame(const Float4x4& view, const Float4x4& projection) override;
+    void EndFrame() override;
+
+    void SetPass(RenderPass pass) override;
+    void DrawQuadInstances(const QuadInstance* pInstances, uint32_t count) override;
+    void DrawTextQuads(const TextVertex* pVertices, uint32_t numQuads) override;
+
+private:
+    // Adds the rectangle between two opposite corners, in world space, to the frame's draws
+    void AddDraw(RenderPass pass, const Float2& corner0, const Float2& corner3, const Float2& texCoord0, const Float2& texCoord3);
+    void BinDraws();
+    void RasterizeTile(uint32_t tile);
+    void DrawTextSpan(uint32_t* pRow, int minX, int maxX, const Draw& draw, int y) const;
+};
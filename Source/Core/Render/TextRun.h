@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "RenderBackend.h"
+
+// Text laid out once and drawn on every frame after: Renderer::UpdateTextRun() lays it out again only
+// when the text, its position or size, or the font atlas change, and Renderer::RenderTextRun() copies
+// the glyph vertices into the frame's text batch.
+class TextRun
+{
+    friend class Renderer;
+
+    std::string             m_text;
+    Float2                  m_pos;
+    float                   m_size;
+    uint32_t                m_fontAtlasVersion;     // Of the Renderer's atlas the vertices were laid out with, 0 if never
+
+    std::vector<TextVertex> m_vertices;
+    uint32_t                m_numLayouts;
+
+public:
+    TextRun() : m_size(0.0f), m_fontAtlasVersion(0), m_numLayouts(0) {}
+
+    const std::string& GetText() const { return m_text; }
+    size_t GetNumGlyphs() const { return m_vertices.size() / 4; }
+
+    // How many times the run has been laid out
+    uint32_t GetNumLayouts() const { return m_numLayouts; }
+};
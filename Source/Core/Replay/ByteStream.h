@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Little endian binary writer/reader with LEB128 varints. Small values (run lengths, ticks, scores)
+// take a single byte.
+
+class ByteWriter
+{
+    std::vector<uint8_t> m_data;
+
+public:
+    void WriteU8(uint8_t value) { m_data.push_back(value); }
+
+    void WriteU32(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            m_data.push_back((uint8_t)(value >> (i * 8)));
+    }
+
+    void WriteU64(uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+            m_data.push_back((uint8_t)(value >> (i * 8)));
+    }
+
+    void WriteVarint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            m_data.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        m_data.push_back((uint8_t)value);
+    }
+
+    // Signed values are zigzag encoded so that small negative numbers stay small
+    void WriteSignedVarint(int64_t value) { WriteVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63)); }
+
+    void WriteBytes(const void* pData, size_t size)
+    {
+        const uint8_t* pBytes = (const uint8_t*)pData;
+        m_data.insert(m_data.end(), pBytes, pBytes + size);
+    }
+
+    size_t GetSize() const { return m_data.size(); }
+    const std::vector<uint8_t>& GetData() const { return m_data; }
+    std::vector<uint8_t>& GetData() { return m_data; }
+    void Clear() { m_data.clear(); }
+};
+
+// Reads from a buffer it does not own. Reading past the end fails softly: the value read is 0 and
+// HasError() turns true, so a whole record can be parsed before checking for errors once.
+class ByteReader
+{
+    const uint8_t*  m_pData;
+    size_t          m_size;
+    size_t          m_pos;
+    bool            m_error;
+
+public:
+    ByteReader() : m_pData(nullptr), m_size(0), m_pos(0), m_error(false) {}
+    ByteReader(const uint8_t* pData, size_t size) : m_pData(pData), m_size(size), m_pos(0), m_error(false) {}
+
+    uint8_t ReadU8()
+    {
+        if (m_pos + 1 > m_size)
+            return Fail();
+        return m_pData[m_pos++];
+    }
+
+    uint32_t ReadU32()
+    {
+        if (m_pos + 4 > m_size)
+            return Fail();
+
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+            value |= (uint32_t)m_pData[m_pos++] << (i * 8);
+        return value;
+    }
+
+    uint64_t ReadU64()
+    {
+        if (m_pos + 8 > m_size)
+            return Fail();
+
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= (uint64_t)m_pData[m_pos++] << (i * 8);
+        return value;
+    }
+
+    uint64_t ReadVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (m_pos >= m_size)
+                return Fail();
+
+            uint8_t byte = m_pData[m_pos++];
+            value |= (uint64_t)(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+
+        return Fail();
+    }
+
+    int64_t ReadSignedVarint()
+    {
+        uint64_t value = ReadVarint();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    const uint8_t* ReadBytes(size_t size)
+    {
+        if (size > m_size - m_pos)
+        {
+            Fail();
+            return nullptr;
+        }
+
+        const uint8_t* pBytes = m_pData + m_pos;
+        m_pos += size;
+        return pBytes;
+    }
+
+    void Seek(size_t pos)
+    {
+        if (pos > m_size)
+            Fail();
+        else
+            m_pos = pos;
+    }
+
+    size_t GetPos() const { return m_pos; }
+    size_t GetSize() const { return m_size; }
+    bool IsAtEnd() const { return m_pos >= m_size; }
+    bool HasError() const { return m_error; }
+
+private:
+    uint8_t Fail()
+    {
+        m_error = true;
+        m_pos = m_size;
+        return 0;
+    }
+};
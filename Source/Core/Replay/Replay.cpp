@@ -0,0 +1,412 @@
+#include <cassert>
+#include <climits>
+#include "Replay.h"
+
+static const uint32_t ReplayMagic = 0x4c505250; // "PRPL"
+static const uint8_t ReplayVersion = 1;
+
+static const uint8_t ReplayFlag_FixedPoint = 1 << 0;
+
+static uint8_t PackInput(const MatchInput& input, uint8_t recordedPaddleMask)
+{
+    uint8_t packed = input.start ? (1 << 4) : 0;
+    for (size_t i = 0; i < Match::NumPaddles; ++i)
+    {
+        if (recordedPaddleMask & (1 << i))
+            packed |= (uint8_t)input.paddles[i] << (i * 2);
+    }
+
+    return packed;
+}
+
+static MatchInput UnpackInput(uint8_t packed)
+{
+    MatchInput input;
+    input.start = (packed & (1 << 4)) != 0;
+    for (size_t i = 0; i < Match::NumPaddles; ++i)
+        input.paddles[i] = (PaddleAction)((packed >> (i * 2)) & 0x3);
+
+    return input;
+}
+
+static void WriteReal(ByteWriter& writer, Real value)
+{
+    writer.WriteSignedVarint((int32_t)GetRealBits(value));
+}
+
+static Real ReadReal(ByteReader& reader)
+{
+    return RealFromBits((uint32_t)(int32_t)reader.ReadSignedVarint());
+}
+
+static void WriteSnapshot(ByteWriter& writer, const MatchSnapshot& snapshot)
+{
+    writer.WriteU8((uint8_t)snapshot.state);
+    writer.WriteVarint((uint32_t)snapshot.paddleScore1);
+    writer.WriteVarint((uint32_t)snapshot.paddleScore2);
+
+    for (size_t i = 0; i < Match::NumPaddles; ++i)
+    {
+        WriteReal(writer, snapshot.paddlePos[i].x);
+        WriteReal(writer, snapshot.paddlePos[i].y);
+        WriteReal(writer, snapshot.paddleVelocity[i].x);
+        WriteReal(writer, snapshot.paddleVelocity[i].y);
+    }
+
+    WriteReal(writer, snapshot.ballPos.x);
+    WriteReal(writer, snapshot.ballPos.y);
+    WriteReal(writer, snapshot.ballVelocity.x);
+    WriteReal(writer, snapshot.ballVelocity.y);
+}
+
+// Scores are stored unsigned; a match never goes past its winning score
+static bool ReadScore(ByteReader& reader, int winningScore, int& outScore)
+{
+    uint64_t score = reader.ReadVarint();
+    outScore = (int)score;
+    return score <= (uint64_t)winningScore;
+}
+
+// False if the state or the scores are ones no match can be in, which a damaged replay would
+// otherwise load into the Match it plays back
+static bool ReadSnapshot(ByteReader& reader, int winningScore, MatchSnapshot& snapshot)
+{
+    uint8_t state = reader.ReadU8();
+    snapshot.state = (GameState)state;
+    bool valid = state >= (uint8_t)GameState::Initializing && state <= (uint8_t)GameState::Running;
+    valid &= ReadScore(reader, winningScore, snapshot.paddleScore1);
+    valid &= ReadScore(reader, winningScore, snapshot.paddleScore2);
+
+    for (size_t i = 0; i < Match::NumPaddles; ++i)
+    {
+        snapshot.paddlePos[i].x = ReadReal(reader);
+        snapshot.paddlePos[i].y = ReadReal(reader);
+        snapshot.paddleVelocity[i].x = ReadReal(reader);
+        snapshot.paddleVelocity[i].y = ReadReal(reader);
+    }
+
+    snapshot.ballPos.x = ReadReal(reader);
+    snapshot.ballPos.y = ReadReal(reader);
+    snapshot.ballVelocity.x = ReadReal(reader);
+    snapshot.ballVelocity.y = ReadReal(reader);
+
+    return valid;
+}
+
+static void WriteRules(ByteWriter& writer, const MatchRules& rules)
+{
+    WriteReal(writer, rules.worldWidth);
+    WriteReal(writer, rules.worldHeight);
+    WriteReal(writer, rules.paddleScale.x);
+    WriteReal(writer, rules.paddleScale.y);
+    WriteReal(writer, rules.ballScale.x);
+    WriteReal(writer, rules.ballScale.y);
+    WriteReal(writer, rules.ballServeVelocity.x);
+    WriteReal(writer, rules.ballServeVelocity.y);
+    WriteReal(writer, rules.paddleSpeed[0]);
+    WriteReal(writer, rules.paddleSpeed[1]);
+    writer.WriteVarint((uint32_t)rules.winningScore);
+    writer.WriteU8(rules.continuousCollision ? 1 : 0);
+}
+
+static bool ReadRules(ByteReader& reader, MatchRules& rules)
+{
+    rules.worldWidth = ReadReal(reader);
+    rules.worldHeight = ReadReal(reader);
+    rules.paddleScale.x = ReadReal(reader);
+    rules.paddleScale.y = ReadReal(reader);
+    rules.ballScale.x = ReadReal(reader);
+    rules.ballScale.y = ReadReal(reader);
+    rules.ballServeVelocity.x = ReadReal(reader);
+    rules.ballServeVelocity.y = ReadReal(reader);
+    rules.paddleSpeed[0] = ReadReal(reader);
+    rules.paddleSpeed[1] = ReadReal(reader);
+    uint64_t winningScore = reader.ReadVarint();
+    rules.winningScore = (int)winningScore;
+    rules.continuousCollision = reader.ReadU8() != 0;
+
+    return winningScore > 0 && winningScore <= INT_MAX;
+}
+
+struct ReplaySections
+{
+    const uint8_t*  pInputs;
+    size_t          inputsSize;
+    const uint8_t*  pKeyframes;
+    size_t          keyframesSize;
+};
+
+static bool ReadReplay(const uint8_t* pData, size_t size, ReplayInfo& info, ReplaySections& sections)
+{
+    if (pData == nullptr)
+        return false;
+
+    ByteReader reader(pData, size);
+    if (reader.ReadU32() != ReplayMagic || reader.ReadU8() != ReplayVersion)
+        return false;
+
+    uint8_t flags = reader.ReadU8();
+    info.fixedPoint = (flags & ReplayFlag_FixedPoint) != 0;
+    info.deltaTime = RealFromBits((uint32_t)reader.ReadVarint());
+    info.keyframeInterval = (uint32_t)reader.ReadVarint();
+    info.recordedPaddleMask = reader.ReadU8();
+    if (!ReadRules(reader, info.rules))
+        return false;
+
+    sections.inputsSize = (size_t)reader.ReadVarint();
+    sections.keyframesSize = (size_t)reader.ReadVarint();
+    sections.pInputs = reader.ReadBytes(sections.inputsSize);
+    sections.pKeyframes = reader.ReadBytes(sections.keyframesSize);
+
+    info.numTicks = (uint32_t)reader.ReadVarint();
+    info.finalChecksum = reader.ReadU32();
+    bool validScores = ReadScore(reader, info.rules.winningScore, info.paddleScore1);
+    validScores &= ReadScore(reader, info.rules.winningScore, info.paddleScore2);
+
+    if (reader.HasError() || !validScores)
+        return false;
+
+#ifdef PONG_FIXED_POINT
+    const bool fixedPoint = true;
+#else
+    const bool fixedPoint = false;
+#endif
+    // The state is stored as raw number bits, which only mean something to a build using the same number type
+    return info.fixedPoint == fixedPoint;
+}
+
+ReplayWriter::ReplayWriter()
+{
+    m_numKeyframes          = 0;
+    m_runInput              = 0;
+    m_runLength             = 0;
+}
+
+void ReplayWriter::Begin(const MatchRules& rules, Real deltaTime, uint8_t recordedPaddleMask, uint32_t keyframeInterval)
+{
+    m_info.rules = rules;
+    m_info.deltaTime = deltaTime;
+    m_info.keyframeInterval = keyframeInterval;
+    m_info.recordedPaddleMask = recordedPaddleMask;
+#ifdef PONG_FIXED_POINT
+    m_info.fixedPoint = true;
+#else
+    m_info.fixedPoint = false;
+#endif
+    m_info.numTicks = 0;
+    m_info.finalChecksum = 0;
+    m_info.paddleScore1 = 0;
+    m_info.paddleScore2 = 0;
+
+    m_inputs.Clear();
+    m_keyframes.Clear();
+    m_output.Clear();
+    m_numKeyframes = 0;
+    m_runInput = 0;
+    m_runLength = 0;
+}
+
+void ReplayWriter::RecordTick(const MatchInput& input, const Match& match)
+{
+    uint8_t packed = PackInput(input, m_info.recordedPaddleMask);
+    if (m_runLength > 0 && packed != m_runInput)
+        FlushRun();
+
+    m_runInput = packed;
+    ++m_runLength;
+
+    if (m_info.keyframeInterval != 0 && (m_info.numTicks % m_info.keyframeInterval) == 0)
+    {
+        // This tick's input lives in the run that is still open, which will be written at the current end of the inputs
+        MatchSnapshot snapshot;
+        match.SaveSnapshot(snapshot);
+
+        m_keyframes.WriteVarint(m_info.numTicks);
+        m_keyframes.WriteVarint(m_inputs.GetSize());
+        m_keyframes.WriteVarint(m_runLength - 1);
+        WriteSnapshot(m_keyframes, snapshot);
+
+        ++m_numKeyframes;
+    }
+
+    ++m_info.numTicks;
+}
+
+void ReplayWriter::End(const Match& match)
+{
+    if (m_runLength > 0)
+        FlushRun();
+
+    m_info.finalChecksum = match.ComputeChecksum();
+    m_info.paddleScore1 = match.GetPaddleScore1();
+    m_info.paddleScore2 = match.GetPaddleScore2();
+
+    ByteWriter keyframes;
+    keyframes.WriteVarint(m_numKeyframes);
+    keyframes.WriteBytes(m_keyframes.GetData().data(), m_keyframes.GetSize());
+
+    m_output.Clear();
+    m_output.WriteU32(ReplayMagic);
+    m_output.WriteU8(ReplayVersion);
+    m_output.WriteU8(m_info.fixedPoint ? ReplayFlag_FixedPoint : 0);
+    m_output.WriteVarint(GetRealBits(m_info.deltaTime));
+    m_output.WriteVarint(m_info.keyframeInterval);
+    m_output.WriteU8(m_info.recordedPaddleMask);
+    WriteRules(m_output, m_info.rules);
+
+    m_output.WriteVarint(m_inputs.GetSize());
+    m_output.WriteVarint(keyframes.GetSize());
+    m_output.WriteBytes(m_inputs.GetData().data(), m_inputs.GetSize());
+    m_output.WriteBytes(keyframes.GetData().data(), keyframes.GetSize());
+
+    m_output.WriteVarint(m_info.numTicks);
+    m_output.WriteU32(m_info.finalChecksum);
+    m_output.WriteVarint((uint32_t)m_info.paddleScore1);
+    m_output.WriteVarint((uint32_t)m_info.paddleScore2);
+}
+
+void ReplayWriter::FlushRun()
+{
+    m_inputs.WriteVarint(m_runLength);
+    m_inputs.WriteU8(m_runInput);
+    m_runLength = 0;
+}
+
+ReplayPlayer::ReplayPlayer()
+{
+    m_pInputs               = nullptr;
+    m_inputsSize            = 0;
+    m_pPolicy               = ChaseBallAction;
+    m_tick                  = 0;
+    m_runInput              = 0;
+    m_runRemaining          = 0;
+}
+
+bool ReplayPlayer::ReadInfo(const uint8_t* pData, size_t size, ReplayInfo& outInfo)
+{
+    ReplaySections sections;
+    return ReadReplay(pData, size, outInfo, sections);
+}
+
+bool ReplayPlayer::Open(const uint8_t* pData, size_t size)
+{
+    ReplaySections sections;
+    if (!ReadReplay(pData, size, m_info, sections))
+        return false;
+
+    m_pInputs = sections.pInputs;
+    m_inputsSize = sections.inputsSize;
+
+    ByteReader reader(sections.pKeyframes, sections.keyframesSize);
+    uint64_t numKeyframes = reader.ReadVarint();
+
+    m_keyframes.clear();
+    for (uint64_t i = 0; i < numKeyframes && !reader.HasError(); ++i)
+    {
+        Keyframe keyframe;
+        keyframe.tick = (uint32_t)reader.ReadVarint();
+        keyframe.inputOffset = (uint32_t)reader.ReadVarint();
+        keyframe.ticksIntoRun = (uint32_t)reader.ReadVarint();
+        if (!ReadSnapshot(reader, m_info.rules.winningScore, keyframe.snapshot))
+            return false;
+
+        m_keyframes.push_back(keyframe);
+    }
+
+    if (reader.HasError())
+        return false;
+
+    Restart();
+    return true;
+}
+
+void ReplayPlayer::Restart()
+{
+    m_match = Match(m_info.rules);
+    m_tick = 0;
+    m_inputReader = ByteReader(m_pInputs, m_inputsSize);
+    m_runInput = 0;
+    m_runRemaining = 0;
+}
+
+bool ReplayPlayer::Step()
+{
+    if (m_tick >= m_info.numTicks)
+        return false;
+
+    if (m_runRemaining == 0)
+    {
+        m_runRemaining = (uint32_t)m_inputReader.ReadVarint();
+        m_runInput = m_inputReader.ReadU8();
+        if (m_inputReader.HasError() || m_runRemaining == 0)
+            return false;
+    }
+
+    MatchInput input = UnpackInput(m_runInput);
+    for (size_t i = 0; i < Match::NumPaddles; ++i)
+    {
+        if ((m_info.recordedPaddleMask & (1 << i)) == 0)
+            input.paddles[i] = m_pPolicy(m_match, i);
+    }
+
+    m_match.Step(input, m_info.deltaTime);
+
+    --m_runRemaining;
+    ++m_tick;
+
+    return true;
+}
+
+bool ReplayPlayer::Seek(uint32_t tick)
+{
+    if (tick > m_info.numTicks)
+        return false;
+
+    // Closest keyframe at or before the tick; keyframes are stored in tick order
+    const Keyframe* pKeyframe = nullptr;
+    for (const Keyframe& keyframe : m_keyframes)
+    {
+        if (keyframe.tick > tick)
+            break;
+        pKeyframe = &keyframe;
+    }
+
+    // Going forward from the current position is cheaper than going back to a keyframe
+    if (tick < m_tick || (pKeyframe != nullptr && pKeyframe->tick > m_tick))
+    {
+        Restart();
+
+        if (pKeyframe != nullptr)
+        {
+            m_match.LoadSnapshot(pKeyframe->snapshot);
+            m_tick = pKeyframe->tick;
+
+            m_inputReader.Seek(pKeyframe->inputOffset);
+            uint32_t runLength = (uint32_t)m_inputReader.ReadVarint();
+            m_runInput = m_inputReader.ReadU8();
+            if (m_inputReader.HasError() || pKeyframe->ticksIntoRun >= runLength)
+                return false;
+
+            m_runRemaining = runLength - pKeyframe->ticksIntoRun;
+        }
+    }
+
+    while (m_tick < tick)
+    {
+        if (!Step())
+            return false;
+    }
+
+    return true;
+}
+
+bool ReplayPlayer::Verify()
+{
+    while (m_tick < m_info.numTicks)
+    {
+        if (!Step())
+            return false;
+    }
+
+    return m_match.ComputeChecksum() == m_info.finalChecksum;
+}
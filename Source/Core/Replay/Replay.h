@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Simulation/Match.h"
+#include "ByteStream.h"
+
+// Compact binary match replays.
+//
+// A replay holds the rules and step size of the match followed by the per-tick input, run-length
+// encoded with varints (one run per change of input), so a typical match is a few hundred bytes.
+// Paddles that are driven by a deterministic policy (the built-in AI) don't have to be recorded;
+// the player recomputes their actions. Optional keyframes (full state snapshots every N ticks) let
+// the player seek without simulating from the start. The footer stores the tick count and the
+// checksum of the final state, so a replay can be verified by re-running it headless.
+//
+// Layout (all integers varints unless noted):
+//   header:    magic (u32), version (u8), flags (u8), step size bits, keyframe interval,
+//              recorded paddle mask (u8), rules, inputs size, keyframes size
+//   inputs:    { run length, packed MatchInput (u8) } ...
+//   keyframes: count, { tick, input offset, ticks into run, MatchSnapshot } ...
+//   footer:    tick count, final checksum (u32), paddle score 1, paddle score 2
+
+typedef PaddleAction (*PaddlePolicy)(const Match& match, size_t paddleIndex);
+
+struct ReplayInfo
+{
+    MatchRules  rules;
+    Real        deltaTime;
+    uint32_t    keyframeInterval;
+    uint8_t     recordedPaddleMask;     // Bit i set: paddle i's actions are stored in the replay
+    bool        fixedPoint;             // Recorded by a PONG_FIXED_POINT build
+
+    uint32_t    numTicks;
+    uint32_t    finalChecksum;
+    int         paddleScore1;
+    int         paddleScore2;
+};
+
+class ReplayWriter
+{
+    ReplayInfo          m_info;
+    ByteWriter          m_inputs;
+    ByteWriter          m_keyframes;
+    uint32_t            m_numKeyframes;
+    uint8_t             m_runInput;
+    uint32_t            m_runLength;
+    ByteWriter          m_output;
+
+public:
+    static const uint32_t DefaultKeyframeInterval = 240;
+
+    ReplayWriter();
+
+    // recordedPaddleMask: which paddles' actions to store (the others are recomputed on playback).
+    // keyframeInterval: ticks between state snapshots; 0 disables seeking keyframes.
+    void Begin(const MatchRules& rules, Real deltaTime, uint8_t recordedPaddleMask = 0x3,
+        uint32_t keyframeInterval = DefaultKeyframeInterval);
+
+    // Call once per tick, with the input about to be passed to match.Step() and the match before the step
+    void RecordTick(const MatchInput& input, const Match& match);
+
+    // Finishes the replay; the encoded bytes are then available from GetData()
+    void End(const Match& match);
+
+    const std::vector<uint8_t>& GetData() const { return m_output.GetData(); }
+    uint32_t GetNumTicks() const { return m_info.numTicks; }
+
+private:
+    void FlushRun();
+};
+
+class ReplayPlayer
+{
+    struct Keyframe
+    {
+        uint32_t        tick;
+        uint32_t        inputOffset;
+        uint32_t        ticksIntoRun;
+        MatchSnapshot   snapshot;
+    };
+
+    ReplayInfo              m_info;
+    const uint8_t*          m_pInputs;
+    size_t                  m_inputsSize;
+    std::vector<Keyframe>   m_keyframes;
+    PaddlePolicy            m_pPolicy;
+
+    Match                   m_match;
+    uint32_t                m_tick;
+    ByteReader              m_inputReader;
+    uint8_t                 m_runInput;
+    uint32_t                m_runRemaining;
+
+public:
+    ReplayPlayer();
+
+    // The buffer must stay valid while the player is in use
+    bool Open(const uint8_t* pData, size_t size);
+
+    // Policy for the paddles that were not recorded. Defaults to ChaseBallAction.
+    void SetPolicy(PaddlePolicy pPolicy) { m_pPolicy = pPolicy; }
+
+    // Advances one tick. Returns false at the end of the replay (or on corrupt data).
+    bool Step();
+
+    // Puts the match into its state at the given tick, starting from the closest keyframe before it
+    bool Seek(uint32_t tick);
+
+    // Plays the rest of the replay and compares the final state with the recorded checksum
+    bool Verify();
+
+    const ReplayInfo& GetInfo() const { return m_info; }
+    const Match& GetMatch() const { return m_match; }
+    uint32_t GetTick() const { return m_tick; }
+
+    // Parses just the header and footer of a replay
+    static bool ReadInfo(const uint8_t* pData, size_t size, ReplayInfo& outInfo);
+
+private:
+    void Restart();
+};
@@ -0,0 +1,329 @@
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include "ReplayArchive.h"
+#include "Replay.h"
+#include "Platform/File.h"
+
+static const uint32_t ArchiveMagic = 0x52415250; // "PRAR"
+static const uint32_t ArchiveFooterMagic = 0x58415250; // "PRAX"
+static const uint32_t ArchiveRecordMagic = 0x52525250; // "PRRR"
+static const uint32_t ArchiveVersion = 2;
+
+static const size_t ArchiveHeaderSize = 8;
+static const size_t ArchiveFooterSize = 16;
+static const size_t ArchiveRecordHeaderSize = 16;
+static const size_t ArchiveAlignment = alignof(ReplayArchiveEntry);
+
+struct ArchiveFooter
+{
+    uint64_t    indexOffset;
+    uint32_t    numEntries;
+    uint32_t    magic;
+};
+
+struct ArchiveRecordHeader
+{
+    uint32_t    magic;
+    uint32_t    size;
+    uint64_t    matchId;
+};
+
+static_assert(sizeof(ArchiveFooter) == ArchiveFooterSize, "ArchiveFooter is stored as is in archive files");
+static_assert(sizeof(ArchiveRecordHeader) == ArchiveRecordHeaderSize, "ArchiveRecordHeader is stored as is in archive files");
+
+static uint64_t AlignRecordEnd(uint64_t offset)
+{
+    return (offset + ArchiveAlignment - 1) & ~(uint64_t)(ArchiveAlignment - 1);
+}
+
+static bool HasArchiveHeader(const uint8_t* pData, size_t size)
+{
+    if (size < ArchiveHeaderSize)
+        return false;
+
+    uint32_t header[2];
+    memcpy(header, pData, sizeof(header));
+    return header[0] == ArchiveMagic && header[1] == ArchiveVersion;
+}
+
+static bool MakeEntry(uint64_t matchId, uint64_t offset, const uint8_t* pReplay, size_t size, ReplayArchiveEntry& outEntry)
+{
+    ReplayInfo info;
+    if (!ReplayPlayer::ReadInfo(pReplay, size, info))
+        return false;
+
+    outEntry.matchId = matchId;
+    outEntry.offset = offset;
+    outEntry.size = (uint32_t)size;
+    outEntry.numTicks = info.numTicks;
+    outEntry.durationSeconds = (float)info.numTicks * ToFloat(info.deltaTime);
+    outEntry.finalChecksum = info.finalChecksum;
+    outEntry.paddleScore1 = (uint16_t)info.paddleScore1;
+    outEntry.paddleScore2 = (uint16_t)info.paddleScore2;
+    outEntry.reserved = 0;
+
+    return true;
+}
+
+// Checks the header and the footer at the end of a mapped archive and returns the footer's index
+static bool FindIndex(const uint8_t* pData, size_t size, const ReplayArchiveEntry*& pEntries, size_t& numEntries)
+{
+    if (size < ArchiveHeaderSize + ArchiveFooterSize || !HasArchiveHeader(pData, size))
+        return false;
+
+    ArchiveFooter footer;
+    memcpy(&footer, pData + size - ArchiveFooterSize, sizeof(footer));
+    if (footer.magic != ArchiveFooterMagic || (footer.indexOffset % ArchiveAlignment) != 0)
+        return false;
+
+    // Checked before subtracting, so a crafted offset can't wrap around
+    uint64_t indexEnd = size - ArchiveFooterSize;
+    if (footer.indexOffset < ArchiveHeaderSize || footer.indexOffset > indexEnd ||
+        (uint64_t)footer.numEntries * sizeof(ReplayArchiveEntry) != indexEnd - footer.indexOffset)
+    {
+        return false;
+    }
+
+    pEntries = (const ReplayArchiveEntry*)(pData + footer.indexOffset);
+    numEntries = footer.numEntries;
+
+    return true;
+}
+
+// Rebuilds the index of an archive without a valid footer from its records, up to the first one that is
+// incomplete or damaged. outRecordsEnd is where that record (or the old index) starts.
+static bool RecoverIndex(const uint8_t* pData, size_t size, std::vector<ReplayArchiveEntry>& outEntries,
+    uint64_t& outRecordsEnd)
+{
+    if (!HasArchiveHeader(pData, size))
+        return false;
+
+    outEntries.clear();
+    uint64_t pos = ArchiveHeaderSize;
+    while (size - pos >= ArchiveRecordHeaderSize)
+    {
+        ArchiveRecordHeader record;
+        memcpy(&record, pData + pos, sizeof(record));
+
+        uint64_t replayOffset = pos + ArchiveRecordHeaderSize;
+        uint64_t recordEnd = AlignRecordEnd(replayOffset + record.size);
+        ReplayArchiveEntry entry;
+        if (record.magic != ArchiveRecordMagic || recordEnd > size ||
+            !MakeEntry(record.matchId, replayOffset, pData + replayOffset, record.size, entry))
+        {
+            break;
+        }
+
+        outEntries.push_back(entry);
+        pos = recordEnd;
+    }
+
+    outRecordsEnd = pos;
+
+    return true;
+}
+
+ReplayArchive::ReplayArchive()
+{
+    m_pEntries              = nullptr;
+    m_numEntries            = 0;
+    m_recordsEnd            = 0;
+}
+
+bool ReplayArchive::Open(const char* pFilename)
+{
+    Close();
+
+    if (!m_file.Open(pFilename))
+        return false;
+
+    if (FindIndex(m_file.GetData(), m_file.GetSize(), m_pEntries, m_numEntries))
+    {
+        m_recordsEnd = (uint64_t)((const uint8_t*)m_pEntries - m_file.GetData());
+        return true;
+    }
+
+    // Being appended to, or left behind by an interrupted session
+    if (!RecoverIndex(m_file.GetData(), m_file.GetSize(), m_recoveredEntries, m_recordsEnd))
+    {
+        Close();
+        return false;
+    }
+
+    m_pEntries = m_recoveredEntries.data();
+    m_numEntries = m_recoveredEntries.size();
+
+    return true;
+}
+
+const uint8_t* ReplayArchive::GetReplayData(const ReplayArchiveEntry& entry) const
+{
+    // Entries are checked here rather than on Open(), which would touch the whole index
+    if (entry.offset < ArchiveHeaderSize || entry.offset > m_recordsEnd || entry.size > m_recordsEnd - entry.offset)
+        return nullptr;
+
+    return m_file.GetData() + entry.offset;
+}
+
+void ReplayArchive::Close()
+{
+    m_file.Close();
+    m_pEntries = nullptr;
+    m_numEntries = 0;
+    m_recordsEnd = 0;
+    m_recoveredEntries.clear();
+}
+
+ptrdiff_t ReplayArchive::FindMatch(uint64_t matchId) const
+{
+    const ReplayArchiveEntry* pEnd = m_pEntries + m_numEntries;
+    const ReplayArchiveEntry* pEntry = std::lower_bound(m_pEntries, pEnd, matchId,
+        [](const ReplayArchiveEntry& entry, uint64_t id) { return entry.matchId < id; });
+    if (pEntry != pEnd && pEntry->matchId == matchId)
+        return pEntry - m_pEntries;
+
+    // Not sorted by id (or not present); fall back to a scan
+    for (size_t i = 0; i < m_numEntries; ++i)
+    {
+        if (m_pEntries[i].matchId == matchId)
+            return (ptrdiff_t)i;
+    }
+
+    return -1;
+}
+
+ReplayArchiveWriter::ReplayArchiveWriter()
+{
+    m_pFile                 = nullptr;
+    m_fileSize              = 0;
+    m_nextMatchId           = 1;
+    m_indexDirty            = false;
+}
+
+ReplayArchiveWriter::~ReplayArchiveWriter()
+{
+    Close();
+}
+
+bool ReplayArchiveWriter::Open(const char* pFilename)
+{
+    Close();
+
+    m_entries.clear();
+    m_fileSize = 0;
+    m_nextMatchId = 1;
+
+    // Keep the existing index in memory; the one written on Close() has to include it
+    MappedFile existing;
+    if (existing.Open(pFilename) && existing.GetSize() > 0)
+    {
+        const ReplayArchiveEntry* pEntries;
+        size_t numEntries;
+        if (FindIndex(existing.GetData(), existing.GetSize(), pEntries, numEntries))
+        {
+            m_entries.assign(pEntries, pEntries + numEntries);
+            m_fileSize = (uint64_t)((const uint8_t*)pEntries - existing.GetData());
+        }
+        else if (!RecoverIndex(existing.GetData(), existing.GetSize(), m_entries, m_fileSize))
+        {
+            return false;
+        }
+
+        for (const ReplayArchiveEntry& entry : m_entries)
+            m_nextMatchId = std::max(m_nextMatchId, entry.matchId + 1);
+    }
+    existing.Close();
+
+    // New records overwrite the old index (or whatever an interrupted session left after the last
+    // complete record), and Close() writes the index again after them
+    m_indexDirty = true;
+    if (m_fileSize > 0)
+    {
+        std::error_code error;
+        std::filesystem::resize_file(pFilename, m_fileSize, error);
+        if (error)
+            return false;
+    }
+
+    m_pFile = OpenStdioFile(pFilename, "ab");
+    if (m_pFile == nullptr)
+        return false;
+
+    if (m_fileSize == 0)
+    {
+        uint32_t header[2] = { ArchiveMagic, ArchiveVersion };
+        if (!Write(header, sizeof(header)))
+        {
+            Close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ReplayArchiveWriter::Append(uint64_t matchId, const uint8_t* pReplay, size_t size)
+{
+    if (m_pFile == nullptr || size > UINT32_MAX)
+        return false;
+
+    ReplayArchiveEntry entry;
+    if (!MakeEntry(matchId, m_fileSize + ArchiveRecordHeaderSize, pReplay, size, entry))
+        return false;
+
+    ArchiveRecordHeader record;
+    record.magic = ArchiveRecordMagic;
+    record.size = (uint32_t)size;
+    record.matchId = matchId;
+
+    // Records are padded so that the next one, and the index after the last one, start aligned
+    static const uint8_t padding[ArchiveAlignment] = {};
+    uint64_t recordEnd = AlignRecordEnd(m_fileSize + ArchiveRecordHeaderSize + size);
+    if (!Write(&record, sizeof(record)) || !Write(pReplay, size) || !Write(padding, (size_t)(recordEnd - m_fileSize)))
+        return false;
+
+    m_entries.push_back(entry);
+    m_indexDirty = true;
+    m_nextMatchId = std::max(m_nextMatchId, matchId + 1);
+
+    return true;
+}
+
+bool ReplayArchiveWriter::Close()
+{
+    if (m_pFile == nullptr)
+        return true;
+
+    bool ok = true;
+    if (m_indexDirty)
+    {
+        ArchiveFooter footer;
+        footer.indexOffset = m_fileSize;
+        footer.numEntries = (uint32_t)m_entries.size();
+        footer.magic = ArchiveFooterMagic;
+
+        ok &= Write(m_entries.data(), m_entries.size() * sizeof(ReplayArchiveEntry));
+        ok &= Write(&footer, sizeof(footer));
+
+        m_indexDirty = false;
+    }
+
+    ok &= (fclose(m_pFile) == 0);
+    m_pFile = nullptr;
+
+    return ok;
+}
+
+bool ReplayArchiveWriter::Write(const void* pData, size_t size)
+{
+    if (size == 0)
+        return true;
+
+    if (fwrite(pData, 1, size, m_pFile) != size)
+        return false;
+
+    m_fileSize += size;
+    return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+#include "Platform/MappedFile.h"
+
+// Append-only file holding many replays, with a fixed size index record per match so that queries
+// over millions of matches only touch the index, never the replays they skip.
+//
+// Layout:
+//   header:  magic (u32), version (u32)
+//   records: magic (u32), replay size (u32), match id (u64), replay bytes, padded to 8 bytes; back to back
+//   index:   ReplayArchiveEntry[count]
+//   footer:  index offset (u64), count (u32), magic (u32)
+//
+// Appending truncates the archive back to the end of its records and writes the new records there,
+// followed by a new index and footer, so the file only ever holds one index. An archive without a valid
+// footer (a session was interrupted before writing it) is recovered by scanning the records, which is why
+// each one carries its match id and size. Readers map the file and use the index in place, so the format
+// is little endian, like every platform the game runs on.
+
+struct ReplayArchiveEntry
+{
+    uint64_t    matchId;
+    uint64_t    offset;             // Of the replay, from the start of the file
+    uint32_t    size;
+    uint32_t    numTicks;
+    float       durationSeconds;
+    uint32_t    finalChecksum;
+    uint16_t    paddleScore1;
+    uint16_t    paddleScore2;
+    uint32_t    reserved;
+};
+
+static_assert(sizeof(ReplayArchiveEntry) == 40, "ReplayArchiveEntry is stored as is in archive files");
+
+class ReplayArchive
+{
+    MappedFile                      m_file;
+    const ReplayArchiveEntry*       m_pEntries;
+    size_t                          m_numEntries;
+    uint64_t                        m_recordsEnd;           // Replays lie before this offset
+    std::vector<ReplayArchiveEntry> m_recoveredEntries;     // The index rebuilt from the records, if the footer is missing
+
+public:
+    ReplayArchive();
+
+    bool Open(const char* pFilename);
+    void Close();
+
+    size_t GetNumMatches() const { return m_numEntries; }
+    const ReplayArchiveEntry& GetEntry(size_t index) const { return m_pEntries[index]; }
+
+    // Points into the mapped file and is valid until the archive is closed. Null if the entry is corrupt.
+    const uint8_t* GetReplayData(const ReplayArchiveEntry& entry) const;
+
+    // Index of the match with the given id, or -1. Ids are usually appended in increasing order,
+    // in which case this is a binary search.
+    ptrdiff_t FindMatch(uint64_t matchId) const;
+};
+
+class ReplayArchiveWriter
+{
+    FILE*                           m_pFile;
+    uint64_t                        m_fileSize;
+    std::vector<ReplayArchiveEntry> m_entries;
+    uint64_t                        m_nextMatchId;
+    bool                            m_indexDirty;           // The file has no index until Close() writes one
+
+public:
+    ReplayArchiveWriter();
+    ~ReplayArchiveWriter();
+
+    // Opens an existing archive to append to, or creates a new one. The archive has no index until Close().
+    bool Open(const char* pFilename);
+
+    // Writes the index of the matches appended since Open() and closes the file
+    bool Close();
+
+    // Adds an encoded replay (see ReplayWriter). Fails if it isn't a valid replay.
+    bool Append(uint64_t matchId, const uint8_t* pReplay, size_t size);
+
+    // One more than the largest match id so far
+    uint64_t GetNextMatchId() const { return m_nextMatchId; }
+    size_t GetNumMatches() const { return m_entries.size(); }
+
+private:
+    bool Write(const void* pData, size_t size);
+};
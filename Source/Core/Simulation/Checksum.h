@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include "Real.h"
+
+// 32-bit FNV-1a hash used to fingerprint the simulation state after every step. Two runs that produce the
+// same sequence of checksums went through the same states, so recorded matches can be verified without
+// storing or comparing the full state.
+class Checksum
+{
+    uint32_t m_hash;
+
+public:
+    Checksum() : m_hash(2166136261u) {}
+
+    void Add(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            m_hash ^= (value >> (i * 8)) & 0xff;
+            m_hash *= 16777619u;
+        }
+    }
+
+    void Add(int value) { Add((uint32_t)value); }
+    void AddReal(Real value) { Add(GetRealBits(value)); }
+
+    uint32_t Get() const { return m_hash; }
+};
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include "CollisionKernel.h"
+
+#ifdef PONG_SIMD_X86
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace CollisionKernel
+{
+#ifdef PONG_SIMD_X86
+    static bool CpuSupportsAVX2()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // The OS has to save the YMM registers on context switches (OSXSAVE + XCR0 bits 1 and 2)
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    SimdLevel GetSimdLevel()
+    {
+#ifdef PONG_SIMD_X86
+        static const SimdLevel s_level = CpuSupportsAVX2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+        return s_level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    const char* GetSimdLevelName(SimdLevel level)
+    {
+        const char* names[] = { "Scalar", "SSE2", "AVX2" };
+        return names[static_cast<int>(level)];
+    }
+
+    size_t ResolveBallPaddle(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t count)
+    {
+        return ResolveBallPaddle(GetSimdLevel(), pairs, results, count);
+    }
+
+    size_t ResolveBallPaddle(SimdLevel level, const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t count)
+    {
+        switch (level)
+        {
+#ifdef PONG_SIMD_X86
+            case SimdLevel::AVX2:
+                return ResolveBallPaddleAVX2(pairs, results, 0, count);
+
+            case SimdLevel::SSE2:
+                return ResolveBallPaddleSSE2(pairs, results, 0, count);
+#endif
+
+            default:
+                return ResolveBallPaddleScalar(pairs, results, 0, count);
+        }
+    }
+
+    size_t ResolveBallPaddleScalar(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t first, size_t last)
+    {
+        size_t numHits = 0;
+
+        for (size_t i = first; i < last; ++i)
+        {
+            float minX = pairs.ballMinX[i];
+            float minY = pairs.ballMinY[i];
+            float maxX = pairs.ballMaxX[i];
+            float maxY = pairs.ballMaxY[i];
+
+            float paddleMinX = pairs.paddleMinX[i];
+            float paddleMinY = pairs.paddleMinY[i];
+            float paddleMaxX = pairs.paddleMaxX[i];
+            float paddleMaxY = pairs.paddleMaxY[i];
+
+            float penetrationX = 0.0f;
+            float penetrationY = 0.0f;
+
+            bool hit = maxX > paddleMinX && minX < paddleMaxX && maxY > paddleMinY && minY < paddleMaxY;
+            if (hit)
+            {
+                float overlapX = std::min(maxX, paddleMaxX) - std::max(minX, paddleMinX);
+                float overlapY = std::min(maxY, paddleMaxY) - std::max(minY, paddleMinY);
+                if (overlapX > 0.0f && overlapY > 0.0f)
+                {
+                    // Resolve along the axis of least penetration
+                    if (overlapX < overlapY)
+                        penetrationX = (minX + maxX < paddleMinX + paddleMaxX) ? -overlapX : overlapX;
+                    else
+                        penetrationY = (minY + maxY < paddleMinY + paddleMaxY) ? -overlapY : overlapY;
+                }
+
+                ++numHits;
+            }
+
+            results.penetrationX[i] = penetrationX;
+            results.penetrationY[i] = penetrationY;
+            results.hit[i] = hit ? 1 : 0;
+        }
+
+        return numHits;
+    }
+
+#ifdef PONG_SIMD_X86
+    size_t ResolveBallPaddleSSE2(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t first, size_t last)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128i one = _mm_set1_epi32(1);
+
+        size_t numHits = 0;
+
+        size_t i = first;
+        for (; i + 4 <= last; i += 4)
+        {
+            __m128 minX = _mm_loadu_ps(pairs.ballMinX + i);
+            __m128 minY = _mm_loadu_ps(pairs.ballMinY + i);
+            __m128 maxX = _mm_loadu_ps(pairs.ballMaxX + i);
+            __m128 maxY = _mm_loadu_ps(pairs.ballMaxY + i);
+
+            __m128 paddleMinX = _mm_loadu_ps(pairs.paddleMinX + i);
+            __m128 paddleMinY = _mm_loadu_ps(pairs.paddleMinY + i);
+            __m128 paddleMaxX = _mm_loadu_ps(pairs.paddleMaxX + i);
+            __m128 paddleMaxY = _mm_loadu_ps(pairs.paddleMaxY + i);
+
+            __m128 hit = _mm_and_ps(
+                _mm_and_ps(_mm_cmpgt_ps(maxX, paddleMinX), _mm_cmplt_ps(minX, paddleMaxX)),
+                _mm_and_ps(_mm_cmpgt_ps(maxY, paddleMinY), _mm_cmplt_ps(minY, paddleMaxY)));
+
+            __m128 overlapX = _mm_sub_ps(_mm_min_ps(maxX, paddleMaxX), _mm_max_ps(minX, paddleMinX));
+            __m128 overlapY = _mm_sub_ps(_mm_min_ps(maxY, paddleMaxY), _mm_max_ps(minY, paddleMinY));
+            __m128 resolve = _mm_and_ps(hit, _mm_and_ps(_mm_cmpgt_ps(overlapX, zero), _mm_cmpgt_ps(overlapY, zero)));
+
+            // Negate the overlap when the ball's center is left of (below) the paddle's center
+            __m128 negateX = _mm_and_ps(_mm_cmplt_ps(_mm_add_ps(minX, maxX), _mm_add_ps(paddleMinX, paddleMaxX)), signMask);
+            __m128 negateY = _mm_and_ps(_mm_cmplt_ps(_mm_add_ps(minY, maxY), _mm_add_ps(paddleMinY, paddleMaxY)), signMask);
+
+            __m128 alongX = _mm_cmplt_ps(overlapX, overlapY);
+            __m128 penetrationX = _mm_and_ps(_mm_and_ps(resolve, alongX), _mm_xor_ps(overlapX, negateX));
+            __m128 penetrationY = _mm_andnot_ps(alongX, _mm_and_ps(resolve, _mm_xor_ps(overlapY, negateY)));
+
+            _mm_storeu_ps(results.penetrationX + i, penetrationX);
+            _mm_storeu_ps(results.penetrationY + i, penetrationY);
+            _mm_storeu_si128((__m128i*)(results.hit + i), _mm_and_si128(_mm_castps_si128(hit), one));
+
+            int mask = _mm_movemask_ps(hit);
+            numHits += (size_t)((mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1));
+        }
+
+        return numHits + ResolveBallPaddleScalar(pairs, results, i, last);
+    }
+#endif
+}
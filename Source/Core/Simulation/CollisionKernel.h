@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PONG_SIMD_X86 1
+#endif
+
+// Vectorized ball/paddle collision test and least-penetration resolution. It does the same work as
+// BoundingBox::Intersects() followed by the overlap resolution in Match::UpdateBall(), but for many
+// pairs at once: 4 pairs per instruction with SSE2 and 8 with AVX2. The widest instruction set the
+// CPU supports is picked at runtime. Every path gives bit-identical results to the scalar one.
+//
+// It only serves MatchBatch's discrete collision mode (MatchRules::continuousCollision off), and only in
+// float builds. The default continuous mode sweeps each ball with SweepBox() (SweptCollision.h), one
+// match at a time, and doesn't go through this kernel.
+namespace CollisionKernel
+{
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    // Structure of arrays input: element i of every array describes pair i
+    struct BallPaddlePairs
+    {
+        const float*    ballMinX;
+        const float*    ballMinY;
+        const float*    ballMaxX;
+        const float*    ballMaxY;
+
+        const float*    paddleMinX;
+        const float*    paddleMinY;
+        const float*    paddleMaxX;
+        const float*    paddleMaxY;
+    };
+
+    // For every pair: whether the boxes intersect (1) or not (0), and the translation that moves the ball out
+    // of the paddle along the axis of least penetration. The translation is zero for pairs that do not intersect.
+    struct BallPaddleResults
+    {
+        float*          penetrationX;
+        float*          penetrationY;
+        uint32_t*       hit;
+    };
+
+    // The best level supported by this CPU (and by the build)
+    SimdLevel GetSimdLevel();
+    const char* GetSimdLevelName(SimdLevel level);
+
+    // Returns the number of intersecting pairs
+    size_t ResolveBallPaddle(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t count);
+    size_t ResolveBallPaddle(SimdLevel level, const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t count);
+
+    // Individual implementations. Each one processes pairs [first, last).
+    size_t ResolveBallPaddleScalar(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t first, size_t last);
+#ifdef PONG_SIMD_X86
+    size_t ResolveBallPaddleSSE2(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t first, size_t last);
+    size_t ResolveBallPaddleAVX2(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t first, size_t last);
+#endif
+}
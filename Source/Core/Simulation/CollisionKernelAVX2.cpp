@@ -0,0 +1,64 @@
+#include "CollisionKernel.h"
+
+// This file is the only one compiled with AVX2 code generation enabled. Its functions must only be
+// called after CollisionKernel::GetSimdLevel() has confirmed that the CPU supports AVX2.
+
+#ifdef PONG_SIMD_X86
+#include <immintrin.h>
+
+namespace CollisionKernel
+{
+    size_t ResolveBallPaddleAVX2(const BallPaddlePairs& pairs, const BallPaddleResults& results, size_t first, size_t last)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256i one = _mm256_set1_epi32(1);
+
+        size_t numHits = 0;
+
+        size_t i = first;
+        for (; i + 8 <= last; i += 8)
+        {
+            __m256 minX = _mm256_loadu_ps(pairs.ballMinX + i);
+            __m256 minY = _mm256_loadu_ps(pairs.ballMinY + i);
+            __m256 maxX = _mm256_loadu_ps(pairs.ballMaxX + i);
+            __m256 maxY = _mm256_loadu_ps(pairs.ballMaxY + i);
+
+            __m256 paddleMinX = _mm256_loadu_ps(pairs.paddleMinX + i);
+            __m256 paddleMinY = _mm256_loadu_ps(pairs.paddleMinY + i);
+            __m256 paddleMaxX = _mm256_loadu_ps(pairs.paddleMaxX + i);
+            __m256 paddleMaxY = _mm256_loadu_ps(pairs.paddleMaxY + i);
+
+            __m256 hit = _mm256_and_ps(
+                _mm256_and_ps(_mm256_cmp_ps(maxX, paddleMinX, _CMP_GT_OQ), _mm256_cmp_ps(minX, paddleMaxX, _CMP_LT_OQ)),
+                _mm256_and_ps(_mm256_cmp_ps(maxY, paddleMinY, _CMP_GT_OQ), _mm256_cmp_ps(minY, paddleMaxY, _CMP_LT_OQ)));
+
+            __m256 overlapX = _mm256_sub_ps(_mm256_min_ps(maxX, paddleMaxX), _mm256_max_ps(minX, paddleMinX));
+            __m256 overlapY = _mm256_sub_ps(_mm256_min_ps(maxY, paddleMaxY), _mm256_max_ps(minY, paddleMinY));
+            __m256 resolve = _mm256_and_ps(hit,
+                _mm256_and_ps(_mm256_cmp_ps(overlapX, zero, _CMP_GT_OQ), _mm256_cmp_ps(overlapY, zero, _CMP_GT_OQ)));
+
+            // Negate the overlap when the ball's center is left of (below) the paddle's center
+            __m256 negateX = _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_add_ps(minX, maxX), _mm256_add_ps(paddleMinX, paddleMaxX), _CMP_LT_OQ), signMask);
+            __m256 negateY = _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_add_ps(minY, maxY), _mm256_add_ps(paddleMinY, paddleMaxY), _CMP_LT_OQ), signMask);
+
+            __m256 alongX = _mm256_cmp_ps(overlapX, overlapY, _CMP_LT_OQ);
+            __m256 penetrationX = _mm256_and_ps(_mm256_and_ps(resolve, alongX), _mm256_xor_ps(overlapX, negateX));
+            __m256 penetrationY = _mm256_andnot_ps(alongX, _mm256_and_ps(resolve, _mm256_xor_ps(overlapY, negateY)));
+
+            _mm256_storeu_ps(results.penetrationX + i, penetrationX);
+            _mm256_storeu_ps(results.penetrationY + i, penetrationY);
+            _mm256_storeu_si256((__m256i*)(results.hit + i), _mm256_and_si256(_mm256_castps_si256(hit), one));
+
+            for (int mask = _mm256_movemask_ps(hit); mask != 0; mask &= mask - 1)
+                ++numHits;
+        }
+
+        _mm256_zeroupper();
+
+        return numHits + ResolveBallPaddleScalar(pairs, results, i, last);
+    }
+}
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Q16.16 fixed point number. Every operation is plain integer arithmetic, so results are bit-identical
+// on every compiler, optimization level and instruction set. Multiplication and division saturate
+// instead of overflowing.
+class Fixed
+{
+    int32_t m_raw;
+
+public:
+    static const int FractionBits = 16;
+    static const int32_t One = 1 << FractionBits;
+
+    Fixed() : m_raw(0) {}
+    Fixed(float value) : m_raw((int32_t)(value * (float)One + (value < 0.0f ? -0.5f : 0.5f))) {}
+    Fixed(int value) : m_raw(value * One) {}
+
+    static Fixed FromRaw(int32_t raw) { Fixed f; f.m_raw = raw; return f; }
+    static Fixed Max() { return FromRaw(INT32_MAX); }
+
+    int32_t GetRaw() const { return m_raw; }
+    float ToFloat() const { return (float)m_raw / (float)One; }
+
+    Fixed operator-() const { return FromRaw(-m_raw); }
+
+    Fixed& operator+=(Fixed other) { m_raw += other.m_raw; return *this; }
+    Fixed& operator-=(Fixed other) { m_raw -= other.m_raw; return *this; }
+    Fixed& operator*=(Fixed other) { *this = *this * other; return *this; }
+    Fixed& operator/=(Fixed other) { *this = *this / other; return *this; }
+
+    friend Fixed operator+(Fixed a, Fixed b) { return FromRaw(a.m_raw + b.m_raw); }
+    friend Fixed operator-(Fixed a, Fixed b) { return FromRaw(a.m_raw - b.m_raw); }
+
+    friend Fixed operator*(Fixed a, Fixed b)
+    {
+        return FromRaw(Saturate(((int64_t)a.m_raw * (int64_t)b.m_raw) >> FractionBits));
+    }
+
+    friend Fixed operator/(Fixed a, Fixed b)
+    {
+        if (b.m_raw == 0)
+            return FromRaw(a.m_raw >= 0 ? INT32_MAX : -INT32_MAX);
+
+        return FromRaw(Saturate(((int64_t)a.m_raw * One) / b.m_raw));
+    }
+
+    friend bool operator==(Fixed a, Fixed b) { return a.m_raw == b.m_raw; }
+    friend bool operator!=(Fixed a, Fixed b) { return a.m_raw != b.m_raw; }
+    friend bool operator<(Fixed a, Fixed b) { return a.m_raw < b.m_raw; }
+    friend bool operator>(Fixed a, Fixed b) { return a.m_raw > b.m_raw; }
+    friend bool operator<=(Fixed a, Fixed b) { return a.m_raw <= b.m_raw; }
+    friend bool operator>=(Fixed a, Fixed b) { return a.m_raw >= b.m_raw; }
+
+private:
+    static int32_t Saturate(int64_t value)
+    {
+        if (value > INT32_MAX)
+            return INT32_MAX;
+        if (value < -INT32_MAX)
+            return -INT32_MAX;
+        return (int32_t)value;
+    }
+};
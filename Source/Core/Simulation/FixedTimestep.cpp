@@ -0,0 +1,43 @@
+#include <cassert>
+#include "FixedTimestep.h"
+
+FixedTimestep::FixedTimestep(int tickRate, int maxStepsPerFrame)
+{
+    m_stepSeconds           = 0.0;
+    m_maxStepsPerFrame      = 0;
+    m_accumulator           = 0.0;
+
+    SetTickRate(tickRate);
+    SetMaxStepsPerFrame(maxStepsPerFrame);
+}
+
+void FixedTimestep::SetTickRate(int tickRate)
+{
+    assert(tickRate > 0 && "Tick rate must be positive");
+    m_stepSeconds = 1.0 / (double)tickRate;
+}
+
+void FixedTimestep::SetMaxStepsPerFrame(int maxStepsPerFrame)
+{
+    assert(maxStepsPerFrame > 0 && "At least one step per frame must be allowed");
+    m_maxStepsPerFrame = maxStepsPerFrame;
+}
+
+int FixedTimestep::Advance(double elapsedSeconds)
+{
+    if (elapsedSeconds > 0.0)
+        m_accumulator += elapsedSeconds;
+
+    int numSteps = 0;
+    while (m_accumulator >= m_stepSeconds && numSteps < m_maxStepsPerFrame)
+    {
+        m_accumulator -= m_stepSeconds;
+        ++numSteps;
+    }
+
+    // Drop the time we could not catch up on
+    if (m_accumulator >= m_stepSeconds)
+        m_accumulator = m_stepSeconds * 0.999;
+
+    return numSteps;
+}
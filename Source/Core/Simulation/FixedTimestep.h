@@ -0,0 +1,32 @@
+#pragma once
+
+// Turns variable frame times into a whole number of fixed size simulation steps. Leftover time is
+// carried over to the next frame and exposed as an interpolation factor for rendering. When a frame
+// takes so long that more than the maximum number of catch-up steps would be needed, the excess time
+// is dropped, so a hitch slows the game down for a moment instead of stalling it further.
+class FixedTimestep
+{
+    double  m_stepSeconds;
+    int     m_maxStepsPerFrame;
+    double  m_accumulator;
+
+public:
+    static const int DefaultTickRate = 120;
+    static const int DefaultMaxStepsPerFrame = 8;
+
+    explicit FixedTimestep(int tickRate = DefaultTickRate, int maxStepsPerFrame = DefaultMaxStepsPerFrame);
+
+    void SetTickRate(int tickRate);
+    void SetMaxStepsPerFrame(int maxStepsPerFrame);
+
+    // Adds the real time elapsed since the last frame and returns the number of steps to simulate now
+    int Advance(double elapsedSeconds);
+
+    void Reset() { m_accumulator = 0.0; }
+
+    float GetStepSeconds() const { return (float)m_stepSeconds; }
+    int GetTickRate() const { return (int)(1.0 / m_stepSeconds + 0.5); }
+
+    // How far (0..1) the current time is between the last simulated step and the next one
+    float GetAlpha() const { return (float)(m_accumulator / m_stepSeconds); }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include "Vec2.h"
+#include "Threading/MpscQueue.h"
+
+enum class GameState;
+
+enum class GameEventType : uint8_t
+{
+    WallHit,
+    PaddleHit,
+    Scored,
+    StateChanged,
+};
+
+// Something that happened during a simulation step, for audio, stats, UI and the like to react to
+struct GameEvent
+{
+    GameEventType   type;
+    uint8_t         paddleIndex;    // PaddleHit: the paddle that was hit. Scored: the side that scored.
+    GameState       state;          // StateChanged: the new state
+    Vec2            position;       // WallHit, PaddleHit: where the ball touched
+    int             paddleScore1;   // Scored: the score after the point
+    int             paddleScore2;
+};
+
+// A Match publishes its events here (see Match::SetEventQueue); consumers drain it at their own pace.
+// When the queue is full new events are dropped, the simulation never waits for its consumers.
+typedef MpscQueue<GameEvent, 256> GameEventQueue;
@@ -0,0 +1,470 @@
+#include <cassert>
+#include <algorithm>
+#include "Match.h"
+#include "SweptCollision.h"
+#include "Checksum.h"
+
+MatchRules::MatchRules()
+{
+    worldWidth          = 640.0f;
+    worldHeight         = 480.0f;
+    paddleScale         = Vec2(10.0f, 60.0f);
+    ballScale           = Vec2(10.0f, 10.0f);
+    ballServeVelocity   = Vec2(-350.0f, 300.0f);
+    paddleSpeed[0]      = 300.0f;
+    paddleSpeed[1]      = 290.0f;
+    winningScore        = 5;
+    continuousCollision = true;
+}
+
+Match::Match()
+    : Match(MatchRules())
+{
+}
+
+Match::Match(const MatchRules& rules)
+{
+    m_rules                 = rules;
+
+    m_state                 = GameState::Initializing;
+    m_worldBounds           = Vec2(0.0f, 0.0f);
+    m_paddleScore1          = 0;
+    m_paddleScore2          = 0;
+
+    m_events                = MatchEvent_None;
+    m_numImpacts            = 0;
+
+    m_checksum              = ComputeChecksum();
+
+    m_pEventQueue           = nullptr;
+    m_stateEventPending     = false;
+}
+
+void Match::Step(const MatchInput& input, Real deltaTime)
+{
+    m_events = MatchEvent_None;
+    m_numImpacts = 0;
+
+    GameState previousState = m_state;
+    int previousScore1 = m_paddleScore1;
+    int previousScore2 = m_paddleScore2;
+
+    switch (m_state)
+    {
+        case GameState::Initializing:
+            ChangeState(GameState::LoadingGameEnvironment);
+            break;
+
+        case GameState::LoadingGameEnvironment:
+            break;
+
+        case GameState::WaitingForPlayers:
+        {
+            if (IsOver())
+                break;
+
+            if (input.start)
+                ChangeState(GameState::Running);
+
+            break;
+        }
+
+        case GameState::Running:
+        {
+            // Set the paddles' velocity based on the players' (or AI's) actions
+            for (size_t i = 0; i < NumPaddles; ++i)
+            {
+                switch (input.paddles[i])
+                {
+                    case PaddleAction::Up:
+                        m_paddles[i].velocity.y = m_rules.paddleSpeed[i];
+                        break;
+
+                    case PaddleAction::Down:
+                        m_paddles[i].velocity.y = -m_rules.paddleSpeed[i];
+                        break;
+
+                    default:
+                        m_paddles[i].velocity.y = 0.0f;
+                        break;
+                }
+            }
+
+            for (size_t i = 0; i < NumPaddles; ++i)
+            {
+                UpdatePaddle(m_paddles[i].pos, m_paddles[i].scale, m_paddles[i].velocity, m_paddles[i].bounds, deltaTime);
+            }
+
+            UpdateBall(m_ball.pos, m_ball.scale, m_ball.velocity, m_ball.bounds, m_paddles, NumPaddles, deltaTime);
+
+            break;
+        }
+
+        default:
+            assert(false && "Unrecognized state");
+    }
+
+    m_checksum = ComputeChecksum();
+
+    if (m_pEventQueue != nullptr)
+        PublishEvents(previousState, previousScore1, previousScore2);
+}
+
+bool Match::IsOver() const
+{
+    return m_state == GameState::WaitingForPlayers &&
+        (m_paddleScore1 >= m_rules.winningScore || m_paddleScore2 >= m_rules.winningScore);
+}
+
+void Match::SaveSnapshot(MatchSnapshot& outSnapshot) const
+{
+    outSnapshot.state = m_state;
+    outSnapshot.paddleScore1 = m_paddleScore1;
+    outSnapshot.paddleScore2 = m_paddleScore2;
+
+    for (size_t i = 0; i < NumPaddles; ++i)
+    {
+        outSnapshot.paddlePos[i] = m_paddles[i].pos;
+        outSnapshot.paddleVelocity[i] = m_paddles[i].velocity;
+    }
+
+    outSnapshot.ballPos = m_ball.pos;
+    outSnapshot.ballVelocity = m_ball.velocity;
+}
+
+void Match::LoadSnapshot(const MatchSnapshot& snapshot)
+{
+    m_state = snapshot.state;
+    m_paddleScore1 = snapshot.paddleScore1;
+    m_paddleScore2 = snapshot.paddleScore2;
+
+    // The world is only set up once the match leaves GameState::Initializing
+    if (m_state == GameState::Initializing)
+        m_worldBounds = Vec2(0.0f, 0.0f);
+    else
+        m_worldBounds = Vec2(m_rules.worldWidth, m_rules.worldHeight);
+
+    for (size_t i = 0; i < NumPaddles; ++i)
+    {
+        Paddle& paddle = m_paddles[i];
+        paddle.pos = snapshot.paddlePos[i];
+        paddle.scale = m_rules.paddleScale;
+        paddle.velocity = snapshot.paddleVelocity[i];
+        paddle.bounds.min.x = paddle.pos.x - (paddle.scale.x / 2.0f);
+        paddle.bounds.min.y = paddle.pos.y - (paddle.scale.y / 2.0f);
+        paddle.bounds.max.x = paddle.pos.x + (paddle.scale.x / 2.0f);
+        paddle.bounds.max.y = paddle.pos.y + (paddle.scale.y / 2.0f);
+    }
+
+    m_ball.pos = snapshot.ballPos;
+    m_ball.scale = m_rules.ballScale;
+    m_ball.velocity = snapshot.ballVelocity;
+    m_ball.bounds.min.x = m_ball.pos.x - (m_ball.scale.x / 2.0f);
+    m_ball.bounds.min.y = m_ball.pos.y - (m_ball.scale.y / 2.0f);
+    m_ball.bounds.max.x = m_ball.pos.x + (m_ball.scale.x / 2.0f);
+    m_ball.bounds.max.y = m_ball.pos.y + (m_ball.scale.y / 2.0f);
+
+    m_events = MatchEvent_None;
+    m_numImpacts = 0;
+    m_checksum = ComputeChecksum();
+}
+
+uint32_t Match::ComputeChecksum() const
+{
+    // Keep in sync with MatchBatch::ComputeChecksum()
+    Checksum checksum;
+    checksum.Add((uint32_t)m_state);
+    checksum.Add(m_paddleScore1);
+    checksum.Add(m_paddleScore2);
+
+    for (size_t i = 0; i < NumPaddles; ++i)
+    {
+        checksum.AddReal(m_paddles[i].pos.x);
+        checksum.AddReal(m_paddles[i].pos.y);
+        checksum.AddReal(m_paddles[i].velocity.y);
+    }
+
+    checksum.AddReal(m_ball.pos.x);
+    checksum.AddReal(m_ball.pos.y);
+    checksum.AddReal(m_ball.velocity.x);
+    checksum.AddReal(m_ball.velocity.y);
+
+    return checksum.Get();
+}
+
+void Match::PublishEvents(GameState previousState, int previousScore1, int previousScore2)
+{
+    // Consumers go by state changes (e.g. to end the game), so those are never lost, only late
+    if (m_stateEventPending && m_pEventQueue->TryPush(m_pendingStateEvent))
+        m_stateEventPending = false;
+
+    GameEvent event;
+    event.paddleIndex = 0;
+    event.state = m_state;
+    event.position = m_ball.pos;
+    event.paddleScore1 = m_paddleScore1;
+    event.paddleScore2 = m_paddleScore2;
+
+    if (m_numImpacts > 0)
+    {
+        for (size_t i = 0; i < m_numImpacts; ++i)
+        {
+            const BallImpact& impact = m_impacts[i];
+            event.type = (impact.event == MatchEvent_PaddleHit) ? GameEventType::PaddleHit : GameEventType::WallHit;
+            event.paddleIndex = (impact.normal.x > 0.0f) ? 0 : 1;   // The left paddle faces right
+            event.position = impact.point;
+            m_pEventQueue->TryPush(event);
+        }
+    }
+    else
+    {
+        // The discrete collision pass only reports that something was hit, not where
+        event.position = m_ball.pos;
+        event.paddleIndex = (m_ball.pos.x < m_worldBounds.x / 2.0f) ? 0 : 1;
+
+        if (m_events & MatchEvent_WallHit)
+        {
+            event.type = GameEventType::WallHit;
+            m_pEventQueue->TryPush(event);
+        }
+        if (m_events & MatchEvent_PaddleHit)
+        {
+            event.type = GameEventType::PaddleHit;
+            m_pEventQueue->TryPush(event);
+        }
+    }
+
+    if (m_paddleScore1 != previousScore1 || m_paddleScore2 != previousScore2)
+    {
+        event.type = GameEventType::Scored;
+        event.paddleIndex = (m_paddleScore1 != previousScore1) ? 0 : 1;
+        event.position = m_ball.pos;
+        m_pEventQueue->TryPush(event);
+    }
+
+    if (m_state != previousState)
+    {
+        event.type = GameEventType::StateChanged;
+        event.paddleIndex = 0;
+        if (m_stateEventPending || !m_pEventQueue->TryPush(event))
+        {
+            // Still behind an older one that didn't fit, or full: the newest state replaces the older one
+            m_pendingStateEvent = event;
+            m_stateEventPending = true;
+        }
+    }
+}
+
+void Match::ChangeState(GameState newState)
+{
+    switch (newState)
+    {
+        case GameState::LoadingGameEnvironment:
+        {
+            m_worldBounds.x = m_rules.worldWidth;
+            m_worldBounds.y = m_rules.worldHeight;
+
+            m_paddles[0].pos.x = m_worldBounds.x * 0.05f;
+            m_paddles[0].pos.y = m_worldBounds.y / 2.0f;
+            m_paddles[0].scale = m_rules.paddleScale;
+            m_paddles[0].velocity = Vec2(0.0f, 0.0f);
+            m_paddles[0].bounds.min.x = m_paddles[0].pos.x - (m_paddles[0].scale.x / 2.0f);
+            m_paddles[0].bounds.min.y = m_paddles[0].pos.y - (m_paddles[0].scale.y / 2.0f);
+            m_paddles[0].bounds.max.x = m_paddles[0].pos.x + (m_paddles[0].scale.x / 2.0f);
+            m_paddles[0].bounds.max.y = m_paddles[0].pos.y + (m_paddles[0].scale.y / 2.0f);
+
+            m_paddles[1].pos.x = m_worldBounds.x * 0.95f;
+            m_paddles[1].pos.y = m_worldBounds.y / 2.0f;
+            m_paddles[1].scale = m_rules.paddleScale;
+            m_paddles[1].velocity = Vec2(0.0f, 0.0f);
+            m_paddles[1].bounds.min.x = m_paddles[1].pos.x - (m_paddles[1].scale.x / 2.0f);
+            m_paddles[1].bounds.min.y = m_paddles[1].pos.y - (m_paddles[1].scale.y / 2.0f);
+            m_paddles[1].bounds.max.x = m_paddles[1].pos.x + (m_paddles[1].scale.x / 2.0f);
+            m_paddles[1].bounds.max.y = m_paddles[1].pos.y + (m_paddles[1].scale.y / 2.0f);
+
+            m_ball.pos.x = m_worldBounds.x / 2.0f;
+            m_ball.pos.y = m_worldBounds.y / 2.0f;
+            m_ball.scale = m_rules.ballScale;
+            m_ball.velocity = m_rules.ballServeVelocity;
+            m_ball.bounds.min.x = m_ball.pos.x - (m_ball.scale.x / 2.0f);
+            m_ball.bounds.min.y = m_ball.pos.y - (m_ball.scale.y / 2.0f);
+            m_ball.bounds.max.x = m_ball.pos.x + (m_ball.scale.x / 2.0f);
+            m_ball.bounds.max.y = m_ball.pos.y + (m_ball.scale.y / 2.0f);
+
+            ChangeState(GameState::WaitingForPlayers);
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    m_state = newState;
+}
+
+void Match::UpdatePaddle(Vec2& pos, const Vec2& scale, Vec2& velocity, BoundingBox& bounds, Real deltaTime)
+{
+    pos.x += velocity.x * deltaTime;
+    pos.y += velocity.y * deltaTime;
+
+    // Clamp the paddle's Y position to ensure it stays within the top and bottom edges of the world bounds
+    if (pos.y + (scale.y / 2.0f) > m_worldBounds.y)
+    {
+        pos.y = m_worldBounds.y - (scale.y / 2.0f);
+    }
+    else if (pos.y - (scale.y / 2.0f) < 0.0f)
+    {
+        pos.y = (scale.y / 2.0f);
+    }
+
+    bounds.min.x = pos.x - (scale.x / 2.0f);
+    bounds.min.y = pos.y - (scale.y / 2.0f);
+    bounds.max.x = pos.x + (scale.x / 2.0f);
+    bounds.max.y = pos.y + (scale.y / 2.0f);
+}
+
+void Match::UpdateBall(Vec2& pos, const Vec2& scale, Vec2& velocity, BoundingBox& bounds,
+    const Paddle* paddles, size_t numPaddles, Real deltaTime)
+{
+    if (m_rules.continuousCollision)
+    {
+        BoundingBox paddleBounds[NumPaddles];
+        for (size_t i = 0; i < numPaddles; ++i)
+            paddleBounds[i] = paddles[i].bounds;
+
+        m_events |= MoveBallContinuous(pos, scale, velocity, m_worldBounds, paddleBounds, numPaddles, deltaTime,
+            m_impacts, m_numImpacts);
+
+        bounds.min.x = pos.x - (scale.x / 2.0f);
+        bounds.min.y = pos.y - (scale.y / 2.0f);
+        bounds.max.x = pos.x + (scale.x / 2.0f);
+        bounds.max.y = pos.y + (scale.y / 2.0f);
+    }
+    else
+    {
+        UpdateBallDiscrete(pos, scale, velocity, bounds, paddles, numPaddles, deltaTime);
+    }
+
+    // Check if the ball has passed beyond the left or right edge — update the score accordingly
+    if (pos.x < 0.0f)
+    {
+        ++m_paddleScore2;
+        m_events |= MatchEvent_Scored;
+        ChangeState(GameState::LoadingGameEnvironment);
+    }
+    else if (pos.x > m_worldBounds.x)
+    {
+        ++m_paddleScore1;
+        m_events |= MatchEvent_Scored;
+        ChangeState(GameState::LoadingGameEnvironment);
+    }
+}
+
+void Match::UpdateBallDiscrete(Vec2& pos, const Vec2& scale, Vec2& velocity, BoundingBox& bounds,
+    const Paddle* paddles, size_t numPaddles, Real deltaTime)
+{
+    pos.x += velocity.x * deltaTime;
+    pos.y += velocity.y * deltaTime;
+
+    bounds.min.x = pos.x - (scale.x / 2.0f);
+    bounds.min.y = pos.y - (scale.y / 2.0f);
+    bounds.max.x = pos.x + (scale.x / 2.0f);
+    bounds.max.y = pos.y + (scale.y / 2.0f);
+
+    // Bounce the ball off the top and bottom edges of the world bounds
+    if (pos.y + (scale.y / 2.0f) > m_worldBounds.y)
+    {
+        Real penY = (pos.y + (scale.y / 2.0f)) - m_worldBounds.y; // Penetration depth along the Y-axis
+        pos.y -= penY;
+
+        bounds.min.x -= penY;
+        bounds.min.y -= penY;
+        bounds.max.x -= penY;
+        bounds.max.y -= penY;
+
+        velocity.y = -velocity.y;
+        m_events |= MatchEvent_WallHit;
+    }
+    else if (pos.y + (scale.y / 2.0f) < 0.0f)
+    {
+        Real penY = 0.0f - (pos.y - (scale.y / 2.0f)); // Penetration depth along the Y-axis
+        pos.y += penY;
+
+        bounds.min.x += penY;
+        bounds.min.y += penY;
+        bounds.max.x += penY;
+        bounds.max.y += penY;
+
+        velocity.y = -velocity.y;
+        m_events |= MatchEvent_WallHit;
+    }
+
+    // Bounce the ball off the left and right paddles
+    for (size_t i = 0; i < numPaddles; ++i)
+    {
+        const Paddle& paddle = paddles[i];
+        if (bounds.Intersects(paddle.bounds))
+        {
+            Vec2 penetration;
+
+            Vec2 overlap;
+            overlap.x = std::min(bounds.max.x, paddle.bounds.max.x) - std::max(bounds.min.x, paddle.bounds.min.x);
+            overlap.y = std::min(bounds.max.y, paddle.bounds.max.y) - std::max(bounds.min.y, paddle.bounds.min.y);
+            if (overlap.x > 0.0f && overlap.y > 0.0f)
+            {
+                // Resolve along the axis of least penetration
+                if (overlap.x < overlap.y)
+                {
+                    Real direction = (bounds.min.x + bounds.max.x < paddle.bounds.min.x + paddle.bounds.max.x) ? -1.0f : 1.0f;
+                    penetration.x = direction * overlap.x;
+                    penetration.y = 0.0f;
+                }
+                else
+                {
+                    Real direction = (bounds.min.y + bounds.max.y < paddle.bounds.min.y + paddle.bounds.max.y) ? -1.0f : 1.0f;
+                    penetration.x = 0.0f;
+                    penetration.y = direction * overlap.y;
+                }
+            }
+            else
+            {
+                penetration.x = 0.0f;
+                penetration.y = 0.0f;
+            }
+
+            pos.x += penetration.x;
+            pos.y += penetration.y;
+
+            bounds.min.x += penetration.x;
+            bounds.min.y += penetration.y;
+            bounds.max.x += penetration.x;
+            bounds.max.y += penetration.y;
+
+            velocity.x = -velocity.x;
+            m_events |= MatchEvent_PaddleHit;
+        }
+    }
+}
+
+bool BoundingBox::Intersects(const BoundingBox& box) const
+{
+    return (
+        max.x > box.min.x &&
+        min.x < box.max.x &&
+        max.y > box.min.y &&
+        min.y < box.max.y
+        );
+}
+
+PaddleAction ChaseBallAction(const Match& match, size_t paddleIndex)
+{
+    const Paddle& paddle = match.GetPaddle(paddleIndex);
+    const Ball& ball = match.GetBall();
+
+    if (paddle.pos.y < ball.pos.y)
+        return PaddleAction::Up;
+    else if (paddle.pos.y > ball.pos.y)
+        return PaddleAction::Down;
+
+    return PaddleAction::None;
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "Vec2.h"
+#include "GameEvent.h"
+
+// Platform independent Pong rules. A Match owns the ball, the two paddles, the score and the
+// game state machine, and is advanced by feeding it the players' input once per step. It has
+// no dependency on Win32, D3D11 or DirectSound, so it can be stepped headless.
+
+enum class GameState
+{
+    Invalid = 0,
+    Initializing,
+    LoadingGameEnvironment,
+    WaitingForPlayers,
+    Running,
+};
+
+enum class PaddleAction : uint8_t
+{
+    None = 0,
+    Up,
+    Down,
+};
+
+struct MatchInput
+{
+    PaddleAction    paddles[2];
+    bool            start;
+
+    MatchInput() : paddles{ PaddleAction::None, PaddleAction::None }, start(false) {}
+};
+
+// Bit flags describing what happened during the last call to Match::Step()
+enum MatchEventFlags : uint32_t
+{
+    MatchEvent_None         = 0,
+    MatchEvent_WallHit      = 1 << 0,
+    MatchEvent_PaddleHit    = 1 << 1,
+    MatchEvent_Scored       = 1 << 2,
+};
+
+struct BoundingBox
+{
+    Vec2 min;
+    Vec2 max;
+
+    bool Intersects(const BoundingBox& box) const;
+};
+
+struct Ball
+{
+    Vec2        pos;
+    Vec2        scale;
+
+    Vec2        velocity;
+    BoundingBox bounds;
+};
+
+struct Paddle
+{
+    Vec2        pos;
+    Vec2        scale;
+
+    Vec2        velocity;
+    BoundingBox bounds;
+};
+
+struct BallImpact
+{
+    MatchEventFlags event;      // MatchEvent_WallHit or MatchEvent_PaddleHit
+    Real            time;       // Seconds into the step
+    Vec2            point;      // Where the ball touched the surface
+    Vec2            normal;
+};
+
+static const size_t MaxBallImpactsPerStep = 8;
+
+struct MatchRules
+{
+    Real    worldWidth;
+    Real    worldHeight;
+    Vec2    paddleScale;
+    Vec2    ballScale;
+    Vec2    ballServeVelocity;  // Velocity of the ball at the start of every rally
+    Real    paddleSpeed[2];     // Speed of each paddle while an Up/Down action is held
+    int     winningScore;       // The match is over once either side reaches this score
+
+    // Sweep the ball along its path (see SweptCollision.h) instead of testing for overlap after the move.
+    // Allows much larger steps without the ball tunnelling through the paddles.
+    bool    continuousCollision;
+
+    MatchRules();
+};
+
+// Everything needed to put a Match back into an earlier state. Bounds, scales and the world size are
+// derived from these and the rules.
+struct MatchSnapshot
+{
+    GameState   state;
+    int         paddleScore1;
+    int         paddleScore2;
+    Vec2        paddlePos[2];
+    Vec2        paddleVelocity[2];
+    Vec2        ballPos;
+    Vec2        ballVelocity;
+};
+
+class Match
+{
+    MatchRules      m_rules;
+
+    GameState       m_state;
+    Vec2            m_worldBounds;
+    Paddle          m_paddles[2];
+    Ball            m_ball;
+    int             m_paddleScore1;
+    int             m_paddleScore2;
+
+    uint32_t        m_events;
+    BallImpact      m_impacts[MaxBallImpactsPerStep];
+    size_t          m_numImpacts;
+
+    uint32_t        m_checksum;
+
+    GameEventQueue* m_pEventQueue;
+    GameEvent       m_pendingStateEvent;    // A state change the full queue had no room for, retried every step
+    bool            m_stateEventPending;
+
+public:
+    static const size_t NumPaddles = 2;
+
+    Match();
+    explicit Match(const MatchRules& rules);
+
+    void Step(const MatchInput& input, Real deltaTime);
+
+    // True once the match is waiting for players and one side has reached the winning score
+    bool IsOver() const;
+
+    GameState GetState() const { return m_state; }
+    const Vec2& GetWorldBounds() const { return m_worldBounds; }
+    const Paddle& GetPaddle(size_t index) const { return m_paddles[index]; }
+    const Ball& GetBall() const { return m_ball; }
+    int GetPaddleScore1() const { return m_paddleScore1; }
+    int GetPaddleScore2() const { return m_paddleScore2; }
+    const MatchRules& GetRules() const { return m_rules; }
+
+    // Events (MatchEventFlags) raised by the last call to Step()
+    uint32_t GetEvents() const { return m_events; }
+
+    void SaveSnapshot(MatchSnapshot& outSnapshot) const;
+    void LoadSnapshot(const MatchSnapshot& snapshot);
+
+    // Checksum of the whole match state after the last call to Step(). Identical inputs give identical
+    // checksums; in fixed point builds (PONG_FIXED_POINT) that holds across compilers and machines too.
+    uint32_t GetChecksum() const { return m_checksum; }
+    uint32_t ComputeChecksum() const;
+
+    // Where the ball hit the walls and paddles during the last call to Step() (continuous collision only)
+    const BallImpact* GetImpacts() const { return m_impacts; }
+    size_t GetNumImpacts() const { return m_numImpacts; }
+
+    // Makes Step() push a GameEvent for every wall hit, paddle hit, point and state change. The queue is
+    // not owned, and copies of the match publish to the same queue. Null (the default) turns it off.
+    // Hits and points that don't fit in a full queue are dropped, but a state change is pushed again on
+    // the following steps until it fits (only the newest, if the state changes again meanwhile).
+    void SetEventQueue(GameEventQueue* pEventQueue) { m_pEventQueue = pEventQueue; }
+
+private:
+    void ChangeState(GameState newState);
+    void PublishEvents(GameState previousState, int previousScore1, int previousScore2);
+
+    void UpdatePaddle(Vec2& pos, const Vec2& scale, Vec2& velocity, BoundingBox& bounds, Real deltaTime);
+    void UpdateBall(Vec2& pos, const Vec2& scale, Vec2& velocity, BoundingBox& bounds,
+        const Paddle* paddles, size_t numPaddles, Real deltaTime);
+    void UpdateBallDiscrete(Vec2& pos, const Vec2& scale, Vec2& velocity, BoundingBox& bounds,
+        const Paddle* paddles, size_t numPaddles, Real deltaTime);
+};
+
+// The original right paddle AI: chase the ball's Y position every step
+PaddleAction ChaseBallAction(const Match& match, size_t paddleIndex);
@@ -0,0 +1,440 @@
+#include <cassert>
+#include <algorithm>
+#include "MatchBatch.h"
+#include "CollisionKernel.h"
+#include "SweptCollision.h"
+#include "Checksum.h"
+#include "Threading/JobSystem.h"
+
+MatchBatch::MatchBatch(size_t count, const MatchRules& rules)
+{
+    m_rules                 = rules;
+    m_count                 = count;
+
+    m_paddlePosX[0]         = m_rules.worldWidth * 0.05f;
+    m_paddlePosX[1]         = m_rules.worldWidth * 0.95f;
+    m_paddleHalfScaleX      = m_rules.paddleScale.x / 2.0f;
+    m_paddleHalfScaleY      = m_rules.paddleScale.y / 2.0f;
+    m_ballHalfScaleX        = m_rules.ballScale.x / 2.0f;
+    m_ballHalfScaleY        = m_rules.ballScale.y / 2.0f;
+
+    m_state.resize(count);
+
+    m_ballPosX.resize(count);
+    m_ballPosY.resize(count);
+    m_ballVelocityX.resize(count);
+    m_ballVelocityY.resize(count);
+    m_ballMinX.resize(count);
+    m_ballMinY.resize(count);
+    m_ballMaxX.resize(count);
+    m_ballMaxY.resize(count);
+
+    for (size_t p = 0; p < Match::NumPaddles; ++p)
+    {
+        m_paddleMinX[p].assign(count, m_paddlePosX[p] - m_paddleHalfScaleX);
+        m_paddleMaxX[p].assign(count, m_paddlePosX[p] + m_paddleHalfScaleX);
+        m_paddlePosY[p].resize(count);
+        m_paddleVelocityY[p].resize(count);
+        m_paddleMinY[p].resize(count);
+        m_paddleMaxY[p].resize(count);
+    }
+
+    m_paddleScore1.resize(count);
+    m_paddleScore2.resize(count);
+    m_events.resize(count);
+
+    m_running.resize(count);
+
+    m_serveVelocityX.resize(count);
+    m_serveVelocityY.resize(count);
+
+    m_penetrationX.resize(count);
+    m_penetrationY.resize(count);
+    m_hit.resize(count);
+
+    for (size_t i = 0; i < count; ++i)
+        Reset(i);
+}
+
+void MatchBatch::Reset(size_t index)
+{
+    Reset(index, m_rules.ballServeVelocity);
+}
+
+void MatchBatch::Reset(size_t index, const Vec2& serveVelocity)
+{
+    m_serveVelocityX[index] = serveVelocity.x;
+    m_serveVelocityY[index] = serveVelocity.y;
+
+    m_state[index]          = GameState::Initializing;
+    m_paddleScore1[index]   = 0;
+    m_paddleScore2[index]   = 0;
+    m_events[index]         = MatchEvent_None;
+
+    // Like a newly constructed Match, everything stays zero until the first step puts it in place
+    for (size_t p = 0; p < Match::NumPaddles; ++p)
+    {
+        m_paddlePosY[p][index] = 0.0f;
+        m_paddleVelocityY[p][index] = 0.0f;
+        m_paddleMinY[p][index] = 0.0f;
+        m_paddleMaxY[p][index] = 0.0f;
+    }
+
+    m_ballPosX[index] = 0.0f;
+    m_ballPosY[index] = 0.0f;
+    m_ballVelocityX[index] = 0.0f;
+    m_ballVelocityY[index] = 0.0f;
+    m_ballMinX[index] = 0.0f;
+    m_ballMinY[index] = 0.0f;
+    m_ballMaxX[index] = 0.0f;
+    m_ballMaxY[index] = 0.0f;
+}
+
+void MatchBatch::ResetPositions(size_t index)
+{
+    for (size_t p = 0; p < Match::NumPaddles; ++p)
+    {
+        m_paddlePosY[p][index] = m_rules.worldHeight / 2.0f;
+        m_paddleVelocityY[p][index] = 0.0f;
+        m_paddleMinY[p][index] = m_paddlePosY[p][index] - m_paddleHalfScaleY;
+        m_paddleMaxY[p][index] = m_paddlePosY[p][index] + m_paddleHalfScaleY;
+    }
+
+    m_ballPosX[index] = m_rules.worldWidth / 2.0f;
+    m_ballPosY[index] = m_rules.worldHeight / 2.0f;
+    m_ballVelocityX[index] = m_serveVelocityX[index];
+    m_ballVelocityY[index] = m_serveVelocityY[index];
+    m_ballMinX[index] = m_ballPosX[index] - m_ballHalfScaleX;
+    m_ballMinY[index] = m_ballPosY[index] - m_ballHalfScaleY;
+    m_ballMaxX[index] = m_ballPosX[index] + m_ballHalfScaleX;
+    m_ballMaxY[index] = m_ballPosY[index] + m_ballHalfScaleY;
+}
+
+void MatchBatch::StepAll(const MatchInput* inputs, Real deltaTime)
+{
+    StepRange(0, m_count, inputs, deltaTime);
+}
+
+void MatchBatch::StepAll(const MatchInput* inputs, Real deltaTime, JobSystem& jobs)
+{
+    // Split on whole blocks of matches. The arrays start on a cache line and a block of 64 entries spans
+    // whole lines even for the one byte ones, so no two threads write to the same line of any array.
+    const size_t blockSize = 64;
+    const size_t minBlocksPerJob = 4;
+
+    size_t numBlocks = (m_count + blockSize - 1) / blockSize;
+    jobs.ParallelFor(numBlocks, minBlocksPerJob, [this, inputs, deltaTime, blockSize](size_t beginBlock, size_t endBlock)
+    {
+        StepRange(beginBlock * blockSize, std::min(endBlock * blockSize, m_count), inputs, deltaTime);
+    });
+}
+
+void MatchBatch::StepRange(size_t first, size_t last, const MatchInput* inputs, Real deltaTime)
+{
+    assert(first <= last && last <= m_count);
+
+    const Real worldWidth = m_rules.worldWidth;
+    const Real worldHeight = m_rules.worldHeight;
+
+    // Pass 1: the state machine. Only matches that were already running at the start of the step are simulated,
+    // exactly like Match::Step() which handles a single state per call.
+    for (size_t i = first; i < last; ++i)
+    {
+        m_events[i] = MatchEvent_None;
+        m_running[i] = (m_state[i] == GameState::Running) ? 1 : 0;
+
+        switch (m_state[i])
+        {
+            case GameState::Initializing:
+                ResetPositions(i);
+                m_state[i] = GameState::WaitingForPlayers;
+                break;
+
+            case GameState::WaitingForPlayers:
+                if (!IsOver(i) && inputs[i].start)
+                    m_state[i] = GameState::Running;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // Pass 2: move the paddles and clamp them to the top and bottom edges of the world bounds
+    for (size_t p = 0; p < Match::NumPaddles; ++p)
+    {
+        const Real speed = m_rules.paddleSpeed[p];
+
+        Real* pPosY = m_paddlePosY[p].data();
+        Real* pVelocityY = m_paddleVelocityY[p].data();
+        Real* pMinY = m_paddleMinY[p].data();
+        Real* pMaxY = m_paddleMaxY[p].data();
+
+        for (size_t i = first; i < last; ++i)
+        {
+            if (!m_running[i])
+                continue;
+
+            switch (inputs[i].paddles[p])
+            {
+                case PaddleAction::Up:      pVelocityY[i] = speed;  break;
+                case PaddleAction::Down:    pVelocityY[i] = -speed; break;
+                default:                    pVelocityY[i] = 0.0f;   break;
+            }
+
+            Real posY = pPosY[i] + pVelocityY[i] * deltaTime;
+
+            if (posY + m_paddleHalfScaleY > worldHeight)
+                posY = worldHeight - m_paddleHalfScaleY;
+            else if (posY - m_paddleHalfScaleY < 0.0f)
+                posY = m_paddleHalfScaleY;
+
+            pPosY[i] = posY;
+            pMinY[i] = posY - m_paddleHalfScaleY;
+            pMaxY[i] = posY + m_paddleHalfScaleY;
+        }
+    }
+
+    if (m_rules.continuousCollision)
+        MoveBallsContinuous(first, last, deltaTime);
+    else
+        MoveBallsDiscrete(first, last, deltaTime);
+
+    // Pass 5: update the score once the ball has passed beyond the left or right edge
+    for (size_t i = first; i < last; ++i)
+    {
+        if (!m_running[i])
+            continue;
+
+        if (m_ballPosX[i] < 0.0f)
+            ++m_paddleScore2[i];
+        else if (m_ballPosX[i] > worldWidth)
+            ++m_paddleScore1[i];
+        else
+            continue;
+
+        m_events[i] |= MatchEvent_Scored;
+        ResetPositions(i);
+        m_state[i] = GameState::WaitingForPlayers;
+    }
+}
+
+void MatchBatch::MoveBallsContinuous(size_t first, size_t last, Real deltaTime)
+{
+    // Pass 3: sweep each ball along its path against the walls and the paddles. This is scalar, one match at
+    // a time; the vectorized collision kernel only serves the discrete mode below.
+    const Vec2 worldBounds(m_rules.worldWidth, m_rules.worldHeight);
+
+    for (size_t i = first; i < last; ++i)
+    {
+        if (!m_running[i])
+            continue;
+
+        BoundingBox paddleBounds[Match::NumPaddles];
+        for (size_t p = 0; p < Match::NumPaddles; ++p)
+        {
+            paddleBounds[p].min = Vec2(m_paddleMinX[p][i], m_paddleMinY[p][i]);
+            paddleBounds[p].max = Vec2(m_paddleMaxX[p][i], m_paddleMaxY[p][i]);
+        }
+
+        Vec2 pos(m_ballPosX[i], m_ballPosY[i]);
+        Vec2 velocity(m_ballVelocityX[i], m_ballVelocityY[i]);
+
+        size_t numImpacts = 0;
+        m_events[i] |= MoveBallContinuous(pos, m_rules.ballScale, velocity, worldBounds, paddleBounds, Match::NumPaddles,
+            deltaTime, nullptr, numImpacts);
+
+        m_ballPosX[i] = pos.x;
+        m_ballPosY[i] = pos.y;
+        m_ballVelocityX[i] = velocity.x;
+        m_ballVelocityY[i] = velocity.y;
+        m_ballMinX[i] = pos.x - m_ballHalfScaleX;
+        m_ballMinY[i] = pos.y - m_ballHalfScaleY;
+        m_ballMaxX[i] = pos.x + m_ballHalfScaleX;
+        m_ballMaxY[i] = pos.y + m_ballHalfScaleY;
+    }
+}
+
+void MatchBatch::MoveBallsDiscrete(size_t first, size_t last, Real deltaTime)
+{
+    const Real worldHeight = m_rules.worldHeight;
+
+    // Pass 3: move the ball and bounce it off the top and bottom edges of the world bounds
+    for (size_t i = first; i < last; ++i)
+    {
+        if (!m_running[i])
+            continue;
+
+        Real posX = m_ballPosX[i] + m_ballVelocityX[i] * deltaTime;
+        Real posY = m_ballPosY[i] + m_ballVelocityY[i] * deltaTime;
+
+        Real minX = posX - m_ballHalfScaleX;
+        Real minY = posY - m_ballHalfScaleY;
+        Real maxX = posX + m_ballHalfScaleX;
+        Real maxY = posY + m_ballHalfScaleY;
+
+        if (posY + m_ballHalfScaleY > worldHeight)
+        {
+            Real penY = (posY + m_ballHalfScaleY) - worldHeight;
+            posY -= penY;
+
+            minX -= penY;
+            minY -= penY;
+            maxX -= penY;
+            maxY -= penY;
+
+            m_ballVelocityY[i] = -m_ballVelocityY[i];
+            m_events[i] |= MatchEvent_WallHit;
+        }
+        else if (posY + m_ballHalfScaleY < 0.0f)
+        {
+            Real penY = 0.0f - (posY - m_ballHalfScaleY);
+            posY += penY;
+
+            minX += penY;
+            minY += penY;
+            maxX += penY;
+            maxY += penY;
+
+            m_ballVelocityY[i] = -m_ballVelocityY[i];
+            m_events[i] |= MatchEvent_WallHit;
+        }
+
+        m_ballPosX[i] = posX;
+        m_ballPosY[i] = posY;
+        m_ballMinX[i] = minX;
+        m_ballMinY[i] = minY;
+        m_ballMaxX[i] = maxX;
+        m_ballMaxY[i] = maxY;
+    }
+
+#ifdef PONG_FIXED_POINT
+    // Pass 4: bounce the ball off the left and right paddles. The collision kernel is float only, so fixed point
+    // builds resolve the overlap with the same scalar code as Match.
+    for (size_t p = 0; p < Match::NumPaddles; ++p)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            if (!m_running[i])
+                continue;
+
+            Real minX = m_ballMinX[i];
+            Real minY = m_ballMinY[i];
+            Real maxX = m_ballMaxX[i];
+            Real maxY = m_ballMaxY[i];
+
+            Real paddleMinX = m_paddleMinX[p][i];
+            Real paddleMinY = m_paddleMinY[p][i];
+            Real paddleMaxX = m_paddleMaxX[p][i];
+            Real paddleMaxY = m_paddleMaxY[p][i];
+
+            m_hit[i] = (maxX > paddleMinX && minX < paddleMaxX && maxY > paddleMinY && minY < paddleMaxY) ? 1 : 0;
+            m_penetrationX[i] = 0.0f;
+            m_penetrationY[i] = 0.0f;
+            if (!m_hit[i])
+                continue;
+
+            Real overlapX = std::min(maxX, paddleMaxX) - std::max(minX, paddleMinX);
+            Real overlapY = std::min(maxY, paddleMaxY) - std::max(minY, paddleMinY);
+            if (overlapX > 0.0f && overlapY > 0.0f)
+            {
+                if (overlapX < overlapY)
+                    m_penetrationX[i] = (minX + maxX < paddleMinX + paddleMaxX) ? -overlapX : overlapX;
+                else
+                    m_penetrationY[i] = (minY + maxY < paddleMinY + paddleMaxY) ? -overlapY : overlapY;
+            }
+        }
+
+        ApplyPaddleHits(first, last);
+    }
+#else
+    // Pass 4: bounce the ball off the left and right paddles. The intersection test and the least-penetration
+    // resolution run in the vectorized collision kernel. Paddles are handled one after the other, as in Match.
+    for (size_t p = 0; p < Match::NumPaddles; ++p)
+    {
+        CollisionKernel::BallPaddlePairs pairs;
+        pairs.ballMinX = m_ballMinX.data() + first;
+        pairs.ballMinY = m_ballMinY.data() + first;
+        pairs.ballMaxX = m_ballMaxX.data() + first;
+        pairs.ballMaxY = m_ballMaxY.data() + first;
+        pairs.paddleMinX = m_paddleMinX[p].data() + first;
+        pairs.paddleMinY = m_paddleMinY[p].data() + first;
+        pairs.paddleMaxX = m_paddleMaxX[p].data() + first;
+        pairs.paddleMaxY = m_paddleMaxY[p].data() + first;
+
+        CollisionKernel::BallPaddleResults results;
+        results.penetrationX = m_penetrationX.data() + first;
+        results.penetrationY = m_penetrationY.data() + first;
+        results.hit = m_hit.data() + first;
+
+        if (CollisionKernel::ResolveBallPaddle(pairs, results, last - first) != 0)
+            ApplyPaddleHits(first, last);
+    }
+#endif
+}
+
+void MatchBatch::ApplyPaddleHits(size_t first, size_t last)
+{
+    for (size_t i = first; i < last; ++i)
+    {
+        if (!m_running[i] || !m_hit[i])
+            continue;
+
+        Real penetrationX = m_penetrationX[i];
+        Real penetrationY = m_penetrationY[i];
+
+        m_ballPosX[i] += penetrationX;
+        m_ballPosY[i] += penetrationY;
+
+        m_ballMinX[i] += penetrationX;
+        m_ballMinY[i] += penetrationY;
+        m_ballMaxX[i] += penetrationX;
+        m_ballMaxY[i] += penetrationY;
+
+        m_ballVelocityX[i] = -m_ballVelocityX[i];
+        m_events[i] |= MatchEvent_PaddleHit;
+    }
+}
+
+bool MatchBatch::IsOver(size_t index) const
+{
+    return m_state[index] == GameState::WaitingForPlayers &&
+        (m_paddleScore1[index] >= m_rules.winningScore || m_paddleScore2[index] >= m_rules.winningScore);
+}
+
+uint32_t MatchBatch::ComputeChecksum(size_t index) const
+{
+    // Keep in sync with Match::ComputeChecksum()
+    Checksum checksum;
+    checksum.Add((uint32_t)m_state[index]);
+    checksum.Add(m_paddleScore1[index]);
+    checksum.Add(m_paddleScore2[index]);
+
+    // The paddles' x is constant here, but only set by Match's first step
+    bool initializing = (m_state[index] == GameState::Initializing);
+    for (size_t p = 0; p < Match::NumPaddles; ++p)
+    {
+        checksum.AddReal(initializing ? Real(0.0f) : m_paddlePosX[p]);
+        checksum.AddReal(m_paddlePosY[p][index]);
+        checksum.AddReal(m_paddleVelocityY[p][index]);
+    }
+
+    checksum.AddReal(m_ballPosX[index]);
+    checksum.AddReal(m_ballPosY[index]);
+    checksum.AddReal(m_ballVelocityX[index]);
+    checksum.AddReal(m_ballVelocityY[index]);
+
+    return checksum.Get();
+}
+
+size_t MatchBatch::CountOver() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        if (IsOver(i))
+            ++count;
+    }
+
+    return count;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Match.h"
+#include "Platform/AlignedAllocator.h"
+
+class JobSystem;
+
+// Steps many independent matches at once. The state of every match is stored as a structure
+// of arrays (one contiguous array per field) and all matches are advanced by a single call to
+// StepAll(), so there is no per-match object, virtual call or pointer chasing in the hot loop.
+// The rules are the same as Match::Step(), and a match stepped here with the same inputs ends
+// up in exactly the same state as a Match would.
+class MatchBatch
+{
+    // Cache line aligned, so that StepAll() can split every array between threads on whole lines
+    template <typename T>
+    using BatchArray = std::vector<T, AlignedAllocator<T, 64>>;
+
+    MatchRules              m_rules;
+    size_t                  m_count;
+
+    // Constant for every match of the batch
+    Real                    m_paddlePosX[Match::NumPaddles];
+    Real                    m_paddleHalfScaleX;
+    Real                    m_paddleHalfScaleY;
+    Real                    m_ballHalfScaleX;
+    Real                    m_ballHalfScaleY;
+
+    BatchArray<GameState>   m_state;
+
+    BatchArray<Real>        m_ballPosX;
+    BatchArray<Real>        m_ballPosY;
+    BatchArray<Real>        m_ballVelocityX;
+    BatchArray<Real>        m_ballVelocityY;
+    BatchArray<Real>        m_ballMinX;
+    BatchArray<Real>        m_ballMinY;
+    BatchArray<Real>        m_ballMaxX;
+    BatchArray<Real>        m_ballMaxY;
+
+    BatchArray<Real>        m_paddleMinX[Match::NumPaddles];  // Constant, but kept per match so that the
+    BatchArray<Real>        m_paddleMaxX[Match::NumPaddles];  // collision kernel can stream over it
+    BatchArray<Real>        m_paddlePosY[Match::NumPaddles];
+    BatchArray<Real>        m_paddleVelocityY[Match::NumPaddles];
+    BatchArray<Real>        m_paddleMinY[Match::NumPaddles];
+    BatchArray<Real>        m_paddleMaxY[Match::NumPaddles];
+
+    BatchArray<int>         m_paddleScore1;
+    BatchArray<int>         m_paddleScore2;
+    BatchArray<uint32_t>    m_events;
+
+    BatchArray<uint8_t>     m_running;
+
+    BatchArray<Real>        m_serveVelocityX;  // The rules' serve velocity unless set by Reset()
+    BatchArray<Real>        m_serveVelocityY;
+
+    // Collision kernel output, reused every step
+    BatchArray<Real>        m_penetrationX;
+    BatchArray<Real>        m_penetrationY;
+    BatchArray<uint32_t>    m_hit;
+
+public:
+    explicit MatchBatch(size_t count, const MatchRules& rules = MatchRules());
+
+    size_t GetCount() const { return m_count; }
+    const MatchRules& GetRules() const { return m_rules; }
+
+    // Puts the match back into its initial state (score 0:0, GameState::Initializing)
+    void Reset(size_t index);
+
+    // Same, with this match serving at the given velocity instead of the rules' (e.g. to randomize training episodes)
+    void Reset(size_t index, const Vec2& serveVelocity);
+
+    // Advances every match by one step. 'inputs' must hold GetCount() elements.
+    void StepAll(const MatchInput* inputs, Real deltaTime);
+
+    // Same as above, with the matches spread over the job system's threads
+    void StepAll(const MatchInput* inputs, Real deltaTime, JobSystem& jobs);
+
+    // Advances the matches [first, last) by one step. Ranges that do not overlap can be stepped concurrently.
+    void StepRange(size_t first, size_t last, const MatchInput* inputs, Real deltaTime);
+
+    bool IsOver(size_t index) const;
+    size_t CountOver() const;
+
+    GameState GetState(size_t index) const { return m_state[index]; }
+    Vec2 GetBallPos(size_t index) const { return Vec2(m_ballPosX[index], m_ballPosY[index]); }
+    Vec2 GetBallVelocity(size_t index) const { return Vec2(m_ballVelocityX[index], m_ballVelocityY[index]); }
+    Vec2 GetPaddlePos(size_t index, size_t paddle) const { return Vec2(m_paddlePosX[paddle], m_paddlePosY[paddle][index]); }
+    int GetPaddleScore1(size_t index) const { return m_paddleScore1[index]; }
+    int GetPaddleScore2(size_t index) const { return m_paddleScore2[index]; }
+    uint32_t GetEvents(size_t index) const { return m_events[index]; }
+
+    // Same value as Match::ComputeChecksum() for a Match in the same state, from its construction on.
+    // 'Benchmarks batch' checks this after every step.
+    uint32_t ComputeChecksum(size_t index) const;
+
+private:
+    void ResetPositions(size_t index);
+
+    void MoveBallsContinuous(size_t first, size_t last, Real deltaTime);
+    void MoveBallsDiscrete(size_t first, size_t last, Real deltaTime);
+    void ApplyPaddleHits(size_t first, size_t last);
+};
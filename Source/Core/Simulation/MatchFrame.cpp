@@ -0,0 +1,20 @@
+#include "MatchFrame.h"
+
+void MatchFrame::Capture(const Match& previous, const Match& current)
+{
+    state = current.GetState();
+    over = current.IsOver();
+    stateChanged = (previous.GetState() != current.GetState());
+    paddleScore1 = current.GetPaddleScore1();
+    paddleScore2 = current.GetPaddleScore2();
+    worldBounds = current.GetWorldBounds();
+
+    for (size_t i = 0; i < Match::NumPaddles; ++i)
+    {
+        paddles[i] = current.GetPaddle(i);
+        previousPaddlePos[i] = previous.GetPaddle(i).pos;
+    }
+
+    ball = current.GetBall();
+    previousBallPos = previous.GetBall().pos;
+}
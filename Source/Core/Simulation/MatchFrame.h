@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include "Match.h"
+
+// What it takes to draw a match: the state after a step plus the positions before it, so a renderer
+// can interpolate between the two. Plain data, so it can be copied to another thread (see TripleBuffer).
+struct MatchFrame
+{
+    GameState   state;
+    bool        over;                   // Won; stays set, so a reader that skips frames still sees it
+    bool        stateChanged;           // Don't interpolate across a state change, e.g. the ball being reset
+    int         paddleScore1;
+    int         paddleScore2;
+    Vec2        worldBounds;
+    Paddle      paddles[2];
+    Ball        ball;
+    Vec2        previousPaddlePos[2];   // Before the last step
+    Vec2        previousBallPos;
+
+    uint64_t    tick;                   // Number of steps simulated so far
+    double      time;                   // When the step was simulated, in seconds on the publisher's clock
+
+    void Capture(const Match& previous, const Match& current);
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "Fixed.h"
+
+// The number type of the simulation. By default it's float. Defining PONG_FIXED_POINT (for every project,
+// or with -DPONG_FIXED_POINT=ON in CMake) switches the whole simulation to Q16.16 fixed point, which
+// gives bit-identical results on every build, so replays can be verified by checksum across machines.
+#ifdef PONG_FIXED_POINT
+typedef Fixed Real;
+
+inline float ToFloat(Real value) { return value.ToFloat(); }
+inline uint32_t GetRealBits(Real value) { return (uint32_t)value.GetRaw(); }
+inline Real RealFromBits(uint32_t bits) { return Fixed::FromRaw((int32_t)bits); }
+inline Real GetRealMax() { return Fixed::Max(); }
+
+// Remainder of value / modulus with the sign of value, like std::fmod. The modulus must not be zero.
+inline Real RealMod(Real value, Real modulus) { return Fixed::FromRaw(value.GetRaw() % modulus.GetRaw()); }
+#else
+typedef float Real;
+
+inline float ToFloat(Real value) { return value; }
+inline uint32_t GetRealBits(Real value) { uint32_t bits; memcpy(&bits, &value, sizeof(bits)); return bits; }
+inline Real RealFromBits(uint32_t bits) { Real value; memcpy(&value, &bits, sizeof(value)); return value; }
+inline Real GetRealMax() { return std::numeric_limits<float>::infinity(); }
+
+inline Real RealMod(Real value, Real modulus) { return std::fmod(value, modulus); }
+#endif
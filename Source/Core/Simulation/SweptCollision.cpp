@@ -0,0 +1,171 @@
+#include <algorithm>
+#include "SweptCollision.h"
+
+static bool SweepAxis(Real center, Real displacement, Real min, Real max, Real& outEntry, Real& outExit)
+{
+    if (displacement == 0.0f)
+    {
+        // Not moving along this axis: it's either overlapping for the whole move or never
+        if (center <= min || center >= max)
+            return false;
+
+        outEntry = -GetRealMax();
+        outExit = GetRealMax();
+        return true;
+    }
+
+    Real t0 = (min - center) / displacement;
+    Real t1 = (max - center) / displacement;
+    outEntry = std::min(t0, t1);
+    outExit = std::max(t0, t1);
+    return true;
+}
+
+bool SweepBox(const Vec2& center, const Vec2& halfScale, const Vec2& displacement, const BoundingBox& target, SweepHit& outHit)
+{
+    // Grow the target by the moving box' half size, then it's a ray (the box' center) against a box
+    Real minX = target.min.x - halfScale.x;
+    Real minY = target.min.y - halfScale.y;
+    Real maxX = target.max.x + halfScale.x;
+    Real maxY = target.max.y + halfScale.y;
+
+    Real entryX, exitX, entryY, exitY;
+    if (!SweepAxis(center.x, displacement.x, minX, maxX, entryX, exitX))
+        return false;
+    if (!SweepAxis(center.y, displacement.y, minY, maxY, entryY, exitY))
+        return false;
+
+    Real entry = std::max(entryX, entryY);
+    Real exit = std::min(exitX, exitY);
+
+    // Grazing contact, moving apart, already overlapping, or too far away to reach this step
+    if (entry >= exit || exit <= 0.0f || entry < 0.0f || entry > 1.0f)
+        return false;
+
+    outHit.time = entry;
+    if (entryX > entryY)
+        outHit.normal = Vec2(displacement.x > 0.0f ? -1.0f : 1.0f, 0.0f);
+    else
+        outHit.normal = Vec2(0.0f, displacement.y > 0.0f ? -1.0f : 1.0f);
+
+    return true;
+}
+
+static void AddImpact(BallImpact* pImpacts, size_t& numImpacts, MatchEventFlags event, Real time, const Vec2& point, const Vec2& normal)
+{
+    if (pImpacts == nullptr || numImpacts >= MaxBallImpactsPerStep)
+        return;
+
+    BallImpact& impact = pImpacts[numImpacts++];
+    impact.event = event;
+    impact.time = time;
+    impact.point = point;
+    impact.normal = normal;
+}
+
+uint32_t MoveBallContinuous(Vec2& pos, const Vec2& scale, Vec2& velocity, const Vec2& worldBounds,
+    const BoundingBox* paddleBounds, size_t numPaddles, Real deltaTime, BallImpact* pImpacts, size_t& outNumImpacts)
+{
+    uint32_t events = MatchEvent_None;
+    outNumImpacts = 0;
+
+    Vec2 halfScale(scale.x / 2.0f, scale.y / 2.0f);
+
+    // A paddle may have moved into the ball since the last step. Push the ball out along the axis of least
+    // penetration first; if the ball was heading into the paddle, it bounces.
+    for (size_t i = 0; i < numPaddles; ++i)
+    {
+        const BoundingBox& paddle = paddleBounds[i];
+
+        Real overlapX = std::min(pos.x + halfScale.x, paddle.max.x) - std::max(pos.x - halfScale.x, paddle.min.x);
+        Real overlapY = std::min(pos.y + halfScale.y, paddle.max.y) - std::max(pos.y - halfScale.y, paddle.min.y);
+        if (overlapX <= 0.0f || overlapY <= 0.0f)
+            continue;
+
+        Vec2 normal;
+        if (overlapX < overlapY)
+        {
+            normal = Vec2(pos.x < (paddle.min.x + paddle.max.x) / 2.0f ? -1.0f : 1.0f, 0.0f);
+            pos.x += normal.x * overlapX;
+            if (velocity.x * normal.x < 0.0f)
+                velocity.x = -velocity.x;
+        }
+        else
+        {
+            normal = Vec2(0.0f, pos.y < (paddle.min.y + paddle.max.y) / 2.0f ? -1.0f : 1.0f);
+            pos.y += normal.y * overlapY;
+            if (velocity.y * normal.y < 0.0f)
+                velocity.y = -velocity.y;
+        }
+
+        events |= MatchEvent_PaddleHit;
+        AddImpact(pImpacts, outNumImpacts, MatchEvent_PaddleHit, 0.0f,
+            Vec2(pos.x - normal.x * halfScale.x, pos.y - normal.y * halfScale.y), normal);
+    }
+
+    Real elapsed = 0.0f;
+    for (size_t bounce = 0; bounce < MaxBallImpactsPerStep && elapsed < deltaTime; ++bounce)
+    {
+        Real remaining = deltaTime - elapsed;
+        Vec2 displacement(velocity.x * remaining, velocity.y * remaining);
+
+        // Find the earliest surface the ball reaches during the rest of the step
+        SweepHit nearest;
+        nearest.time = 2.0f;
+        MatchEventFlags nearestEvent = MatchEvent_None;
+
+        if (displacement.y > 0.0f)
+        {
+            Real t = (worldBounds.y - halfScale.y - pos.y) / displacement.y;
+            if (t <= 1.0f)
+            {
+                nearest.time = std::max(t, Real(0.0f));
+                nearest.normal = Vec2(0.0f, -1.0f);
+                nearestEvent = MatchEvent_WallHit;
+            }
+        }
+        else if (displacement.y < 0.0f)
+        {
+            Real t = (halfScale.y - pos.y) / displacement.y;
+            if (t <= 1.0f)
+            {
+                nearest.time = std::max(t, Real(0.0f));
+                nearest.normal = Vec2(0.0f, 1.0f);
+                nearestEvent = MatchEvent_WallHit;
+            }
+        }
+
+        for (size_t i = 0; i < numPaddles; ++i)
+        {
+            SweepHit hit;
+            if (SweepBox(pos, halfScale, displacement, paddleBounds[i], hit) && hit.time < nearest.time)
+            {
+                nearest = hit;
+                nearestEvent = MatchEvent_PaddleHit;
+            }
+        }
+
+        if (nearestEvent == MatchEvent_None)
+        {
+            pos.x += displacement.x;
+            pos.y += displacement.y;
+            break;
+        }
+
+        // Move to the point of impact and reflect the velocity about the surface normal
+        pos.x += displacement.x * nearest.time;
+        pos.y += displacement.y * nearest.time;
+        elapsed += remaining * nearest.time;
+
+        if (nearest.normal.x != 0.0f)
+            velocity.x = -velocity.x;
+        else
+            velocity.y = -velocity.y;
+
+        events |= nearestEvent;
+        AddImpact(pImpacts, outNumImpacts, nearestEvent, elapsed,
+            Vec2(pos.x - nearest.normal.x * halfScale.x, pos.y - nearest.normal.y * halfScale.y), nearest.normal);
+    }
+
+    return events;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "Match.h"
+
+// Continuous (swept AABB) collision for the ball. Instead of moving the ball and then looking for
+// overlaps, the ball's path over the whole step is tested against the walls and paddles. The earliest
+// hit is resolved first, the ball bounces, and the rest of the step continues from the impact point.
+// This keeps the ball from tunnelling through a paddle at any speed or step size.
+
+struct SweepHit
+{
+    Real    time;       // Fraction (0..1) of the displacement travelled before the boxes touch
+    Vec2    normal;     // Surface normal of the target at the point of contact
+};
+
+// Sweeps a box (given by its center and half size) along 'displacement' against a static box. Returns
+// false if the boxes do not touch during the move, if they move apart, or if they already overlap.
+bool SweepBox(const Vec2& center, const Vec2& halfScale, const Vec2& displacement, const BoundingBox& target, SweepHit& outHit);
+
+// Moves the ball by velocity * deltaTime and bounces it off the top and bottom edges of the world
+// and off the paddles, in the order it reaches them. Up to MaxBallImpactsPerStep impacts are written
+// to 'pImpacts' (may be null). Returns the MatchEventFlags raised.
+uint32_t MoveBallContinuous(Vec2& pos, const Vec2& scale, Vec2& velocity, const Vec2& worldBounds,
+    const BoundingBox* paddleBounds, size_t numPaddles, Real deltaTime, BallImpact* pImpacts, size_t& outNumImpacts);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Real.h"
+
+struct Vec2
+{
+    Real x;
+    Real y;
+
+    Vec2() : x(0.0f), y(0.0f) {}
+    Vec2(Real _x, Real _y) : x(_x), y(_y) {}
+};
+
+inline Vec2 Lerp(const Vec2& a, const Vec2& b, Real t)
+{
+    return Vec2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+}
@@ -0,0 +1,227 @@
+#include <cassert>
+#include <algorithm>
+#include "JobSystem.h"
+
+// Which queue the current thread owns, so that jobs started from a job go to its own worker's deque
+static thread_local const JobSystem* t_pJobSystem = nullptr;
+static thread_local size_t t_queueIndex = 0;
+
+// Number of empty polls before an idle worker goes to sleep. Keeps workers awake between the
+// batches of back to back parallel-fors without burning a core when there is no work.
+static const int IdleSpinCount = 256;
+
+JobSystem::JobSystem(size_t numWorkers)
+{
+    if (numWorkers == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        numWorkers = (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+    }
+
+    m_numQueuedJobs = 0;
+    m_numSleepers = 0;
+    m_stop = false;
+
+    m_queues = std::vector<WorkerQueue>(numWorkers + 1);
+
+    m_workers.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i)
+        m_workers.emplace_back(&JobSystem::WorkerThread, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (std::thread& worker : m_workers)
+        worker.join();
+}
+
+void JobSystem::Run(std::function<void()> function, JobCounter* pCounter)
+{
+    if (pCounter != nullptr)
+        pCounter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+    Push(Job{ std::move(function), pCounter });
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, std::function<void()> function, JobCounter* pCounter)
+{
+    if (pCounter != nullptr)
+        pCounter->m_count.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (dependency.m_count.load(std::memory_order_acquire) != 0)
+        {
+            dependency.m_pendingJobs.push_back(JobCounter::PendingJob{ std::move(function), pCounter });
+            return;
+        }
+    }
+
+    Push(Job{ std::move(function), pCounter });
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    size_t queueIndex = (t_pJobSystem == this) ? t_queueIndex : m_workers.size();
+
+    while (!counter.IsDone())
+    {
+        if (!TryRunOne(queueIndex))
+            std::this_thread::yield();
+    }
+
+    // The job that finished the counter may still be inside Finish(); once it has released the lock
+    // the counter is no longer used and the caller may destroy it
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minBatchSize, const std::function<void(size_t begin, size_t end)>& function)
+{
+    if (count == 0)
+        return;
+
+    // A few batches per thread, so that threads that finish early can steal from the others
+    size_t maxBatches = GetNumThreads() * 4;
+    size_t batchSize = std::max(std::max(minBatchSize, (size_t)1), (count + maxBatches - 1) / maxBatches);
+    if (batchSize >= count)
+    {
+        function(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t begin = batchSize; begin < count; begin += batchSize)
+    {
+        size_t end = std::min(begin + batchSize, count);
+        Run([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+
+    function(0, batchSize);
+    Wait(counter);
+}
+
+void JobSystem::WorkerThread(size_t workerIndex)
+{
+    t_pJobSystem = this;
+    t_queueIndex = workerIndex;
+
+    int idleCount = 0;
+    for (;;)
+    {
+        if (TryRunOne(workerIndex))
+        {
+            idleCount = 0;
+            continue;
+        }
+
+        if (++idleCount < IdleSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Counted before the jobs are checked, so that Push() either sees the sleeper or is seen by it
+        // (both sides are sequentially consistent)
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_numSleepers.fetch_add(1);
+        m_wakeUp.wait(lock, [this]() { return m_stop || m_numQueuedJobs.load() != 0; });
+        m_numSleepers.fetch_sub(1);
+        if (m_stop && m_numQueuedJobs.load(std::memory_order_acquire) == 0)
+            break;
+
+        idleCount = 0;
+    }
+
+    t_pJobSystem = nullptr;
+}
+
+void JobSystem::Push(Job&& job)
+{
+    size_t queueIndex = (t_pJobSystem == this) ? t_queueIndex : m_workers.size();
+
+    WorkerQueue& queue = m_queues[queueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    m_numQueuedJobs.fetch_add(1);
+
+    // Producers only serialize on the sleep lock when a worker is asleep. Taking it then makes sure a
+    // worker that just saw no jobs is either already waiting or will see this one.
+    if (m_numSleepers.load() != 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wakeUp.notify_one();
+    }
+}
+
+bool JobSystem::TryPop(size_t queueIndex, Job& outJob)
+{
+    WorkerQueue& queue = m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    outJob = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::TrySteal(size_t queueIndex, Job& outJob)
+{
+    WorkerQueue& queue = m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    outJob = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+    return true;
+}
+
+bool JobSystem::TryRunOne(size_t queueIndex)
+{
+    if (m_numQueuedJobs.load(std::memory_order_acquire) == 0)
+        return false;
+
+    Job job;
+    bool found = TryPop(queueIndex, job);
+
+    // Steal from the others, starting with the next queue so that thieves spread out
+    for (size_t i = 1; !found && i < m_queues.size(); ++i)
+        found = TrySteal((queueIndex + i) % m_queues.size(), job);
+
+    if (!found)
+        return false;
+
+    m_numQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+    job.function();
+    Finish(job.pCounter);
+
+    return true;
+}
+
+void JobSystem::Finish(JobCounter* pCounter)
+{
+    if (pCounter == nullptr)
+        return;
+
+    std::vector<JobCounter::PendingJob> pendingJobs;
+    {
+        std::lock_guard<std::mutex> lock(pCounter->m_mutex);
+        if (pCounter->m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            pendingJobs.swap(pCounter->m_pendingJobs);
+    }
+
+    for (JobCounter::PendingJob& pendingJob : pendingJobs)
+        Push(Job{ std::move(pendingJob.function), pendingJob.pCounter });
+}
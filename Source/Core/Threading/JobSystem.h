@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+// Counts unfinished jobs. Jobs started with a counter increment it and decrement it when they finish,
+// so a counter can be waited on (JobSystem::Wait) or used to hold back other jobs until it reaches
+// zero (JobSystem::RunAfter). Must outlive the jobs that refer to it.
+class JobCounter
+{
+    friend class JobSystem;
+
+    struct PendingJob
+    {
+        std::function<void()>   function;
+        JobCounter*             pCounter;
+    };
+
+    std::atomic<size_t>     m_count;
+    std::mutex              m_mutex;
+    std::vector<PendingJob> m_pendingJobs;  // Started by RunAfter(), waiting for the count to reach zero
+
+public:
+    JobCounter() : m_count(0) {}
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return m_count.load(std::memory_order_acquire) == 0; }
+};
+
+// Work-stealing job scheduler. Every worker thread has its own deque: it pushes and pops jobs at the
+// back (so related work stays hot in its cache), and idle workers steal from the front of the others'
+// deques. Jobs started from outside the workers go into a shared deque that everyone steals from.
+// Threads that wait for a counter run jobs in the meantime instead of blocking, so jobs can start and
+// wait for other jobs without deadlocking the pool.
+class JobSystem
+{
+    struct Job
+    {
+        std::function<void()>   function;
+        JobCounter*             pCounter;
+    };
+
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex              mutex;
+        std::deque<Job>         jobs;
+    };
+
+    std::vector<std::thread>    m_workers;
+    std::vector<WorkerQueue>    m_queues;       // One per worker, plus the shared one at the end
+
+    std::atomic<size_t>         m_numQueuedJobs;
+    std::atomic<size_t>         m_numSleepers;  // Workers waiting on m_wakeUp; Push() only notifies if there are any
+    std::mutex                  m_sleepMutex;
+    std::condition_variable     m_wakeUp;
+    bool                        m_stop;
+
+public:
+    // numWorkers = 0 uses one worker per hardware thread, minus one for the calling thread
+    explicit JobSystem(size_t numWorkers = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Worker threads plus the thread that waits for them
+    size_t GetNumThreads() const { return m_workers.size() + 1; }
+
+    void Run(std::function<void()> function, JobCounter* pCounter = nullptr);
+
+    // Starts the job once 'dependency' has reached zero (immediately if it already has)
+    void RunAfter(JobCounter& dependency, std::function<void()> function, JobCounter* pCounter = nullptr);
+
+    // Runs other jobs until the counter reaches zero
+    void Wait(JobCounter& counter);
+
+    // Calls function(begin, end) over [0, count) in batches of at least minBatchSize, spread over all
+    // threads including the calling one. Returns when all batches are done.
+    void ParallelFor(size_t count, size_t minBatchSize, const std::function<void(size_t begin, size_t end)>& function);
+
+private:
+    void WorkerThread(size_t workerIndex);
+
+    void Push(Job&& job);
+    bool TryPop(size_t queueIndex, Job& outJob);
+    bool TrySteal(size_t queueIndex, Job& outJob);
+    bool TryRunOne(size_t queueIndex);
+    void Finish(JobCounter* pCounter);
+};
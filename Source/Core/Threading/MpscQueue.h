@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+
+// Bounded lock-free ring for any number of producer threads and one consumer thread. Capacity must be
+// a power of two. Every slot carries a sequence number that says whether it is ready to be written or
+// read in the current lap around the ring, so producers only contend on the tail index, and the consumer
+// never has to wait for a producer that claimed a slot but hasn't finished writing it — it sees the
+// queue as empty until then.
+template <typename T, size_t Capacity>
+class MpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    static const size_t Mask = Capacity - 1;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T                   item;
+    };
+
+    alignas(64) std::atomic<size_t> m_tail;     // Next slot to claim, shared by the producers
+    alignas(64) size_t              m_head;     // Next slot to read, owned by the consumer
+    alignas(64) Slot                m_slots[Capacity];
+
+public:
+    MpscQueue() : m_tail(0), m_head(0)
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread
+    bool TryPush(const T& item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot& slot = m_slots[tail & Mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            ptrdiff_t difference = (ptrdiff_t)sequence - (ptrdiff_t)tail;
+
+            if (difference == 0)
+            {
+                // The slot is free in this lap; claim it
+                if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                {
+                    slot.item = item;
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The consumer hasn't read this slot's item from the previous lap yet
+                return false;
+            }
+            else
+            {
+                // Another producer claimed the slot first
+                tail = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer only
+    bool TryPop(T& outItem)
+    {
+        Slot& slot = m_slots[m_head & Mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+            return false;
+
+        outItem = slot.item;
+        slot.sequence.store(m_head + Capacity, std::memory_order_release);
+        ++m_head;
+        return true;
+    }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+
+// Bounded lock-free ring for one producer thread and one consumer thread. Capacity must be a power of
+// two. Neither side ever blocks or allocates: TryPush() fails when the ring is full and TryPop() fails
+// when it is empty. The two indices live on separate cache lines so the threads don't fight over them.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    static const size_t Mask = Capacity - 1;
+
+    alignas(64) std::atomic<size_t> m_head;     // Next slot to read, written by the consumer
+    alignas(64) std::atomic<size_t> m_tail;     // Next slot to write, written by the producer
+    alignas(64) T                   m_items[Capacity];
+
+public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only
+    bool TryPush(const T& item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_items[tail & Mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    bool TryPop(T& outItem)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        outItem = m_items[head & Mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called while the other side is active
+    size_t GetSize() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+    bool IsEmpty() const { return GetSize() == 0; }
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+// Lock-free hand-over of the latest value from one writer thread to one reader thread. The writer fills
+// its private buffer and publishes it by swapping it with the shared middle buffer; the reader swaps the
+// middle buffer with its own when a newer value has been published. Neither side ever waits for the other,
+// the reader always sees the newest complete value, and values it was too slow for are skipped.
+template <typename T>
+class TripleBuffer
+{
+    static const uint8_t IndexMask = 0x3;
+    static const uint8_t NewFlag = 0x4;     // Set in m_middle when it holds a value the reader hasn't seen
+
+    T                       m_buffers[3];
+    uint8_t                 m_writeIndex;   // Writer only
+    uint8_t                 m_readIndex;    // Reader only
+    std::atomic<uint8_t>    m_middle;
+
+public:
+    TripleBuffer() : m_writeIndex(0), m_readIndex(1), m_middle(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer: the buffer to fill. Its previous contents are stale, not necessarily the last value written.
+    T& GetWriteBuffer() { return m_buffers[m_writeIndex]; }
+
+    // Writer: makes the write buffer the newest value
+    void Publish()
+    {
+        uint8_t previous = m_middle.exchange(m_writeIndex | NewFlag, std::memory_order_acq_rel);
+        m_writeIndex = previous & IndexMask;
+    }
+
+    // Reader: picks up the newest published value, if there is one. Returns false if nothing new was published.
+    bool Update()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & NewFlag) == 0)
+            return false;
+
+        uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & IndexMask;
+        return true;
+    }
+
+    // Reader: the value picked up by the last Update()
+    const T& GetReadBuffer() const { return m_buffers[m_readIndex]; }
+};
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "3rdParty/json.hpp"
+#include "Render/Font.h"
+
+// Bakes the JSON metrics written by msdf-atlas-gen next to the atlas texture into a font file the game
+// maps and uses in place. The game doesn't parse JSON itself, so this is the only user of nlohmann/json.
+
+// Reads a member of a JSON object, false if it is missing or isn't a number of the right kind. The json
+// accessors throw or are undefined on anything else, and the file comes from outside the build.
+static bool ReadNumber(const nlohmann::json& object, const char* key, uint32_t& outValue)
+{
+    nlohmann::json::const_iterator it = object.find(key);
+    if (it == object.end() || !it->is_number_unsigned() || it->get<uint64_t>() > UINT32_MAX)
+        return false;
+
+    outValue = it->get<uint32_t>();
+    return true;
+}
+
+static bool ReadNumber(const nlohmann::json& object, const char* key, float& outValue)
+{
+    nlohmann::json::const_iterator it = object.find(key);
+    if (it == object.end() || !it->is_number())
+        return false;
+
+    outValue = it->get<float>();
+    return true;
+}
+
+// Reads left, bottom, right and top of the bounds object under key. A glyph without bounds (a space)
+// has none, which leaves them zero.
+static bool ReadBounds(const nlohmann::json& glyphData, const char* key, float& outLeft, float& outBottom,
+    float& outRight, float& outTop)
+{
+    nlohmann::json::const_iterator it = glyphData.find(key);
+    if (it == glyphData.end())
+        return true;
+
+    return it->is_object() && ReadNumber(*it, "left", outLeft) && ReadNumber(*it, "bottom", outBottom) &&
+        ReadNumber(*it, "right", outRight) && ReadNumber(*it, "top", outTop);
+}
+
+static bool ReadFontMetaData(const char* fileName, FontAtlasBuilder& outBuilder, size_t& outNumGlyphs)
+{
+    std::ifstream fs(fileName);
+    if (!fs.is_open())
+        return false;
+
+    const nlohmann::json json = nlohmann::json::parse(fs, nullptr, false);
+    if (json.is_discarded() || !json.is_object())
+        return false;
+
+    nlohmann::json::const_iterator atlasData = json.find("atlas");
+    nlohmann::json::const_iterator glyphsData = json.find("glyphs");
+    if (atlasData == json.end() || !atlasData->is_object() || glyphsData == json.end() || !glyphsData->is_array())
+        return false;
+
+    uint32_t size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    if (!ReadNumber(*atlasData, "size", size) || !ReadNumber(*atlasData, "width", width) ||
+        !ReadNumber(*atlasData, "height", height))
+        return false;
+
+    outBuilder = FontAtlasBuilder(size, width, height);
+
+    outNumGlyphs = 0;
+    for (const nlohmann::json& glyphData : *glyphsData)
+    {
+        Glyph glyph;
+        memset(&glyph, 0, sizeof(Glyph));
+
+        if (!glyphData.is_object() || !ReadNumber(glyphData, "unicode", glyph.unicode) ||
+            !ReadNumber(glyphData, "advance", glyph.advance))
+            return false;
+
+        if (!ReadBounds(glyphData, "planeBounds", glyph.planeLeft, glyph.planeBottom, glyph.planeRight, glyph.planeTop) ||
+            !ReadBounds(glyphData, "atlasBounds", glyph.atlasLeft, glyph.atlasBottom, glyph.atlasRight, glyph.atlasTop))
+            return false;
+
+        outBuilder.AddGlyph(glyph);
+        ++outNumGlyphs;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        printf("Usage: FontBaker <msdf-atlas-gen JSON> <output .font>\n");
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    FontAtlasBuilder builder(0, 0, 0);
+    size_t numGlyphs = 0;
+    if (!ReadFontMetaData(argv[1], builder, numGlyphs))
+    {
+        fprintf(stderr, "Couldn't read %s\n", argv[1]);
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point parsed = std::chrono::steady_clock::now();
+
+    if (!builder.Write(argv[2]))
+    {
+        fprintf(stderr, "Couldn't write %s\n", argv[2]);
+        return 1;
+    }
+
+    // Opened the way the game does, to check the file and show what the bake saves at startup
+    std::chrono::steady_clock::time_point opening = std::chrono::steady_clock::now();
+    FontAtlas atlas;
+    bool opened = atlas.Open(argv[2]);
+    std::chrono::steady_clock::time_point openedTime = std::chrono::steady_clock::now();
+
+    if (!opened || atlas.GetNumGlyphs() == 0)
+    {
+        fprintf(stderr, "%s doesn't open as a font\n", argv[2]);
+        return 1;
+    }
+
+    printf("%s: %zu glyphs (%zu distinct), JSON parsed in %.1f us, baked font opens in %.1f us\n", argv[2], numGlyphs,
+        atlas.GetNumGlyphs(), std::chrono::duration<double>(parsed - start).count() * 1e6,
+        std::chrono::duration<double>(openedTime - opening).count() * 1e6);
+
+    return 0;
+}
@@ -3,9 +3,14 @@
 #include <new>
 #include "Audio.h"
 #include "Debugging/Logger.h"
+#include "Platform/MappedFile.h"
 
 #define RELEASE_COM(x) { if (x != nullptr) { x->Release(); x = nullptr; } }
 
+// KSDATAFORMAT_SUBTYPE_PCM and KSDATAFORMAT_SUBTYPE_IEEE_FLOAT, without linking ksguid.lib for them
+static const GUID SubFormatPcm      = { 0x00000001, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 } };
+static const GUID SubFormatFloat    = { 0x00000003, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 } };
+
 Audio::Audio()
 {
     m_pDirectSound          = nullptr;
@@ -64,112 +69,54 @@ void Audio::Uninitialize()
     RELEASE_COM(m_pDirectSound);
 }
 
-bool Audio::LoadWavFile(const char* name, LPDIRECTSOUNDBUFFER& outSoundBuffer)
+// A plain WAVEFORMATEX only describes mono or stereo 8 or 16-bit PCM. Every other format ReadWaveFile()
+// accepts is described as WAVE_FORMAT_EXTENSIBLE, with the file's speaker positions when it has them.
+static void GetWaveFormat(const WaveFormat& format, WAVEFORMATEXTENSIBLE& outFormat)
 {
-    FILE* fp = nullptr;
-    if (fopen_s(&fp, name, "rb") != 0)
-        return false;
-    
-    fseek(fp, 0, SEEK_END);
-    size_t size = (size_t)ftell(fp);
-    if (size < 1)
-    {
-        fclose(fp);
-        return false;
-    }
-    rewind(fp);
-
-    char* pBuffer = new (std::nothrow) char[size];
-    if (pBuffer == nullptr)
-    {
-        fclose(fp);
-        return false; 
-    }
-    if (fread_s(pBuffer, size, 1, size, fp) != size)
-    {
-        fclose(fp);
-        delete[] pBuffer;
-        return false;
-    }
-
-    fclose(fp);
-
-    unsigned int type = 0;
-    unsigned int length = 0;
-    
-    unsigned int pos = 0;
-
-    type = *((unsigned int*)(pBuffer + pos));
-    pos += sizeof(unsigned int);
-    length = *((unsigned int*)(pBuffer + pos));
-    pos += sizeof(unsigned int);
-    if (type != mmioFOURCC('R', 'I', 'F', 'F'))
-    {
-        delete[] pBuffer;
-        return false;
-    }
-
-    type = *((unsigned int*)(pBuffer + pos));
-    pos += sizeof(unsigned int);
-    if (type != mmioFOURCC('W', 'A', 'V', 'E'))
-    {
-        delete[] pBuffer;
-        return false;
-    }
-
-    WAVEFORMATEX waveformat;
-    ZeroMemory(&waveformat, sizeof(WAVEFORMATEX));
-
-    unsigned char*  pWaveData = nullptr;
-    DWORD           waveDataSize = 0;
-
-    bool copiedWavData = false;
-    while (true)
-    {
-        type = *((unsigned int*)(pBuffer + pos));
-        pos += sizeof(unsigned int);
-        length = *((unsigned int*)(pBuffer + pos));
-        pos += sizeof(unsigned int);
-
-        switch (type)
-        {
-            case mmioFOURCC('f', 'm', 't', ' '):
-                CopyMemory(&waveformat, (pBuffer + pos), length);
-                waveformat.cbSize = (WORD)length;
-                break;
-
-            case mmioFOURCC('d', 'a', 't', 'a'):
-                waveDataSize = length;
-                pWaveData = new unsigned char[waveDataSize];
-                assert(pWaveData != nullptr && "Out of memory in LoadWavFile().");
-
-                CopyMemory(pWaveData, (pBuffer + pos), length);
-
-                copiedWavData = true;
-                
-                break;
-        }
-
-        pos += length;
-        if (length & 1)
-            ++pos;
+    ZeroMemory(&outFormat, sizeof(WAVEFORMATEXTENSIBLE));
+    WAVEFORMATEX& waveformat = outFormat.Format;
+    waveformat.wFormatTag = WAVE_FORMAT_PCM;
+    waveformat.nChannels = format.numChannels;
+    waveformat.nSamplesPerSec = format.samplesPerSecond;
+    waveformat.nAvgBytesPerSec = format.samplesPerSecond * format.blockAlign;
+    waveformat.nBlockAlign = format.blockAlign;
+    waveformat.wBitsPerSample = format.bitsPerSample;
+    if (format.sampleType == WaveSampleType::Pcm && format.bitsPerSample <= 16 && format.numChannels <= 2)
+        return;
+
+    waveformat.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+    waveformat.cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
+    outFormat.Samples.wValidBitsPerSample = format.bitsPerSample;
+    outFormat.SubFormat = (format.sampleType == WaveSampleType::Float) ? SubFormatFloat : SubFormatPcm;
+    outFormat.dwChannelMask = format.channelMask;
+    if (outFormat.dwChannelMask == 0 && format.numChannels == 1)
+        outFormat.dwChannelMask = SPEAKER_FRONT_CENTER;
+    else if (outFormat.dwChannelMask == 0 && format.numChannels == 2)
+        outFormat.dwChannelMask = SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT;
+}
 
-        if (copiedWavData)
-            break;
-    }
-    delete[] pBuffer;
+bool Audio::CreateSoundBuffer(const WaveFile& wave, LPDIRECTSOUNDBUFFER& outSoundBuffer)
+{
+    WAVEFORMATEXTENSIBLE waveformat;
+    GetWaveFormat(wave.format, waveformat);
+    DWORD waveDataSize = (DWORD)wave.samples.size();
 
     DSBUFFERDESC bufferDesc;
     ZeroMemory(&bufferDesc, sizeof(DSBUFFERDESC));
     bufferDesc.dwSize = sizeof(DSBUFFERDESC);
     bufferDesc.dwBufferBytes = waveDataSize;
     bufferDesc.dwReserved = 0;
-    bufferDesc.lpwfxFormat = &waveformat;
+    bufferDesc.lpwfxFormat = &waveformat.Format;
     bufferDesc.guid3DAlgorithm = GUID_NULL;
     bufferDesc.dwFlags = DSBCAPS_CTRLVOLUME;
     HRESULT hr = m_pDirectSound->CreateSoundBuffer(&bufferDesc, &outSoundBuffer, nullptr);
     if (FAILED(hr))
+    {
+        LOG("Audio", Error, "Can't create a sound buffer for %u channels of %u-bit %s at %u Hz (0x%08x)",
+            wave.format.numChannels, wave.format.bitsPerSample, (wave.format.sampleType == WaveSampleType::Float) ? "float" : "PCM",
+            wave.format.samplesPerSecond, (unsigned)hr);
         return false;
+    }
 
     DWORD status;
     hr = outSoundBuffer->GetStatus(&status);
@@ -193,7 +140,8 @@ bool Audio::LoadWavFile(const char* name, LPDIRECTSOUNDBUFFER& outSoundBuffer)
     if (FAILED(hr))
         return false;
 
-    CopyMemory(pLockedSoundBuffer, pWaveData, waveDataSize);
+    // The only copy of the samples: from the file's mapping into the memory DirectSound plays from
+    CopyMemory(pLockedSoundBuffer, wave.samples.data(), waveDataSize);
     
     hr = outSoundBuffer->Unlock((void*)pLockedSoundBuffer, lockedSoundBufferSize, nullptr, 0);
     if (FAILED(hr))
@@ -203,14 +151,33 @@ bool Audio::LoadWavFile(const char* name, LPDIRECTSOUNDBUFFER& outSoundBuffer)
     if (FAILED(hr))
         return false;
 
-    delete[] pWaveData;
     return true;
 }
 
+bool Audio::LoadWavFile(const char* name, LPDIRECTSOUNDBUFFER& outSoundBuffer)
+{
+    MappedFile file;
+    WaveFile wave;
+    if (!file.Open(name) || !ReadWaveFile(std::span<const uint8_t>(file.GetData(), file.GetSize()), wave))
+        return false;
+
+    return CreateSoundBuffer(wave, outSoundBuffer);
+}
+
 bool Audio::LoadSound(const char* name, SoundEvent event)
+{
+    MappedFile file;
+    WaveFile wave;
+    if (!file.Open(name) || !ReadWaveFile(std::span<const uint8_t>(file.GetData(), file.GetSize()), wave))
+        return false;
+
+    return AddSound(wave, event);
+}
+
+bool Audio::AddSound(const WaveFile& wave, SoundEvent event)
 {
     LPDIRECTSOUNDBUFFER pSoundBuffer = nullptr;
-    if (!LoadWavFile(name, pSoundBuffer))
+    if (!CreateSoundBuffer(wave, pSoundBuffer))
         return false;
     
     m_sounds[event] = pSoundBuffer;
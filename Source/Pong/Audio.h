@@ -2,8 +2,12 @@
 
 #include <Windows.h>
 #include <mmsystem.h>
+#include <mmreg.h>
 #include <dsound.h>
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
+#include "Assets/WaveFile.h"
 
 #pragma comment(lib, "dsound.lib")
 
@@ -25,8 +29,11 @@ public:
     bool Initialize(HWND hwnd);
     void Uninitialize();
 
+    // WAV files are parsed with ReadWaveFile(), which is thread safe, so sounds can be parsed on worker threads
+    bool CreateSoundBuffer(const WaveFile& wave, LPDIRECTSOUNDBUFFER& outSoundBuffer);
     bool LoadWavFile(const char* name, LPDIRECTSOUNDBUFFER& outSoundBuffer);
     bool LoadSound(const char* name, SoundEvent event);
+    bool AddSound(const WaveFile& wave, SoundEvent event);
 
     void Play(SoundEvent event);
 };
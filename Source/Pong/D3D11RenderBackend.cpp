@@ -0,0 +1,624 @@
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "D3D11RenderBackend.h"
+#include "Debugging/Logger.h"
+#include "Render/ShaderCache.h"
+
+using namespace DirectX;
+
+#define RELEASE_COM(x) { if (x != nullptr) { x->Release(); x = nullptr; } }
+
+D3D11RenderBackend::D3D11RenderBackend()
+{
+    m_pd3dDevice			= nullptr;
+    m_pd3dDeviceContext		= nullptr;
+    m_pDXGISwapChain		= nullptr;
+    m_pRenderTargetView		= nullptr;
+    ZeroMemory(&m_viewport, sizeof(D3D11_VIEWPORT));
+
+    m_pVertexLayout			= nullptr;
+    m_pVertexShader			= nullptr;
+    m_pPixelShader			= nullptr;
+    
+    m_pTextVertexLayout     = nullptr;
+    m_pTextVertexShader     = nullptr;
+    m_pTextPixelShader      = nullptr;
+
+    m_numPolys              = 0;
+    m_pVertexBuffer         = nullptr;
+    m_pIndexBuffer          = nullptr;
+    m_pInstanceBuffer       = nullptr;
+    m_instanceCapacity      = 0;
+
+    m_pTextVertexBuffer     = nullptr;
+    m_pTextIndexBuffer      = nullptr;
+    m_textQuadCapacity      = 0;
+    m_pFontAtlasTextureRV   = nullptr;
+    m_pSamplerLinear        = nullptr;
+
+    m_pcbPerFrame           = nullptr;
+
+    m_pass                  = RenderPass::Quads;
+
+    m_numShadersCompiled    = 0;
+    m_numShadersCached      = 0;
+}
+
+D3D11RenderBackend::~D3D11RenderBackend()
+{
+    Uninitialize();
+}
+
+struct ShaderSource
+{
+    const char*     assetName;
+    const char*     entryPoint;
+    const char*     profile;
+};
+
+enum ShaderIndex
+{
+    QuadVertexShader,
+    QuadPixelShader,
+    TextVertexShader,
+    TextPixelShader,
+    NumShaders,
+};
+
+// Every shader the backend uses, in ShaderIndex order. The sources are in the asset pack, the cache files
+// (written by the game) next to it.
+static const ShaderSource s_shaderSources[NumShaders] =
+{
+    { "Shader.hlsl",        "VSMain", "vs_4_0" },
+    { "Shader.hlsl",        "PSMain", "ps_4_0" },
+    { "TextShader.hlsl",    "VSMain", "vs_4_0" },
+    { "TextShader.hlsl",    "PSMain", "ps_4_0" },
+};
+
+static const char* ShaderCacheDirectory = "Data/";
+
+static UINT GetShaderCompileFlags()
+{
+    UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
+#ifdef _DEBUG
+    // Set the D3DCOMPILE_DEBUG flag to embed debug information in the shaders.
+    // Setting this flag improves the shader debugging experience, but still allows 
+    // the shaders to be optimized and to run exactly the way they will run in 
+    // the release configuration of this program.
+    flags |= D3DCOMPILE_DEBUG;
+
+    // Disable optimizations to further improve shader debugging
+    flags |= D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+
+    return flags;
+}
+
+// The bytecode from the shader's cache file if that was compiled from the same source and flags, otherwise
+// compiled now and written to the cache file for the next start
+static bool LoadShader(const AssetPack& assets, const ShaderSource& source, std::vector<uint8_t>& outBytecode,
+    bool& outCompiled)
+{
+    outCompiled = false;
+
+    const uint8_t* pSource;
+    size_t sourceSize;
+    if (!assets.FindAsset(source.assetName, pSource, sourceSize))
+    {
+        LOG("LoadShader", Error, "%s is missing from the asset pack", source.assetName);
+        return false;
+    }
+
+    UINT flags = GetShaderCompileFlags();
+    uint64_t key = ComputeShaderKey(pSource, sourceSize, source.entryPoint, source.profile, flags);
+    std::string sourceFileName = std::string(ShaderCacheDirectory) + source.assetName;
+    std::string cacheFileName = GetShaderCacheFileName(sourceFileName.c_str(), source.entryPoint);
+
+    if (ReadShaderCache(cacheFileName.c_str(), key, outBytecode))
+        return true;
+
+    ID3DBlob* pBlob = nullptr;
+    ID3DBlob* pErrorBlob = nullptr;
+    HRESULT hr = D3DCompile(pSource, sourceSize, source.assetName, nullptr, nullptr, source.entryPoint,
+        source.profile, flags, 0, &pBlob, &pErrorBlob);
+    if (pErrorBlob != nullptr)
+    {
+        if (FAILED(hr))
+            LOG("LoadShader", Error, "%s", (const char*)pErrorBlob->GetBufferPointer());
+        pErrorBlob->Release();
+    }
+
+    if (FAILED(hr))
+        return false;
+
+    const uint8_t* pBytecode = (const uint8_t*)pBlob->GetBufferPointer();
+    outBytecode.assign(pBytecode, pBytecode + pBlob->GetBufferSize());
+    pBlob->Release();
+
+    outCompiled = true;
+
+    // Not fatal, the shader is compiled again next time
+    if (!WriteShaderCache(cacheFileName.c_str(), key, outBytecode.data(), outBytecode.size()))
+        LOG("LoadShader", Warning, "Failed to write %s", cacheFileName.c_str());
+
+    return true;
+}
+
+bool D3D11RenderBackend::BuildShaderCache(const AssetPack& assets)
+{
+    for (const ShaderSource& source : s_shaderSources)
+    {
+        std::vector<uint8_t> bytecode;
+        bool compiled;
+        if (!LoadShader(assets, source, bytecode, compiled))
+            return false;
+    }
+
+    return true;
+}
+
+bool D3D11RenderBackend::Initialize(HWND hwnd, const AssetPack& assets)
+{
+    HRESULT hr = S_OK;
+
+    RECT rc;
+    GetClientRect(hwnd, &rc);
+    UINT width = rc.right - rc.left;
+    UINT height = rc.bottom - rc.top;
+
+    UINT createDeviceFlags = 0;
+#ifdef _DEBUG
+    createDeviceFlags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+
+    DXGI_SWAP_CHAIN_DESC swapChainDesc;
+    ZeroMemory(&swapChainDesc, sizeof(DXGI_SWAP_CHAIN_DESC));
+    swapChainDesc.BufferDesc.Width = width;
+    swapChainDesc.BufferDesc.Height = height;
+    swapChainDesc.BufferDesc.RefreshRate.Numerator = 60;
+    swapChainDesc.BufferDesc.RefreshRate.Denominator = 1;
+    swapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    swapChainDesc.BufferDesc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
+    swapChainDesc.BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
+    swapChainDesc.SampleDesc.Count = 1;
+    swapChainDesc.SampleDesc.Quality = 0;
+    swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+    swapChainDesc.BufferCount = 1;
+    swapChainDesc.OutputWindow = hwnd;
+    swapChainDesc.Windowed = TRUE;
+    swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
+    swapChainDesc.Flags = 0;
+
+    D3D_FEATURE_LEVEL featureLevel;
+    hr = D3D11CreateDeviceAndSwapChain(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, createDeviceFlags, nullptr, 0, D3D11_SDK_VERSION,
+        &swapChainDesc, &m_pDXGISwapChain, &m_pd3dDevice, &featureLevel, &m_pd3dDeviceContext);
+    if (FAILED(hr))
+        return false;
+
+    ID3D11Texture2D* pBackBuffer = nullptr;
+    hr = m_pDXGISwapChain->GetBuffer(0, IID_PPV_ARGS(&pBackBuffer));
+    if (FAILED(hr))
+        return false;
+
+    hr = m_pd3dDevice->CreateRenderTargetView(pBackBuffer, nullptr, &m_pRenderTargetView);
+    pBackBuffer->Release();
+    if (FAILED(hr))
+        return false;
+
+    m_viewport.TopLeftX = 0.0f;
+    m_viewport.TopLeftY = 0.0f;
+    m_viewport.Width = (FLOAT)width;
+    m_viewport.Height = (FLOAT)height;
+    m_viewport.MinDepth = 0.0f;
+    m_viewport.MaxDepth = 1.0f;
+
+    std::vector<uint8_t> bytecode[NumShaders];
+    for (int i = 0; i < NumShaders; ++i)
+    {
+        bool compiled;
+        if (!LoadShader(assets, s_shaderSources[i], bytecode[i], compiled))
+            return false;
+
+        if (compiled)
+            ++m_numShadersCompiled;
+        else
+            ++m_numShadersCached;
+    }
+
+    {
+        const std::vector<uint8_t>& vertexShader = bytecode[QuadVertexShader];
+
+        D3D11_INPUT_ELEMENT_DESC inputElementDescs[] =
+        {
+            { "POSITION",      0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+            { "INSTANCEPOS",   0, DXGI_FORMAT_R32G32_FLOAT,    1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+            { "INSTANCESCALE", 0, DXGI_FORMAT_R32G32_FLOAT,    1, 8, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        };
+
+        UINT numElements = ARRAYSIZE(inputElementDescs);
+        hr = m_pd3dDevice->CreateInputLayout(inputElementDescs, numElements, vertexShader.data(),
+            vertexShader.size(), &m_pVertexLayout);
+        if (FAILED(hr))
+            return false;
+
+        hr = m_pd3dDevice->CreateVertexShader(vertexShader.data(), vertexShader.size(), nullptr, &m_pVertexShader);
+        if (FAILED(hr))
+            return false;
+
+        const std::vector<uint8_t>& pixelShader = bytecode[QuadPixelShader];
+        hr = m_pd3dDevice->CreatePixelShader(pixelShader.data(), pixelShader.size(), nullptr, &m_pPixelShader);
+        if (FAILED(hr))
+            return false;
+    }
+
+    {
+        const std::vector<uint8_t>& vertexShader = bytecode[TextVertexShader];
+
+        D3D11_INPUT_ELEMENT_DESC inputElementDescs[] =
+        {
+            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,  0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        };
+
+        UINT numElements = ARRAYSIZE(inputElementDescs);
+        hr = m_pd3dDevice->CreateInputLayout(inputElementDescs, numElements, vertexShader.data(),
+            vertexShader.size(), &m_pTextVertexLayout);
+        if (FAILED(hr))
+            return false;
+
+        hr = m_pd3dDevice->CreateVertexShader(vertexShader.data(), vertexShader.size(), nullptr, &m_pTextVertexShader);
+        if (FAILED(hr))
+            return false;
+
+        const std::vector<uint8_t>& pixelShader = bytecode[TextPixelShader];
+        hr = m_pd3dDevice->CreatePixelShader(pixelShader.data(), pixelShader.size(), nullptr, &m_pTextPixelShader);
+        if (FAILED(hr))
+            return false;
+    }
+
+    {
+        // A --- B
+        // |   / |
+        // | /   | 
+        // C --- D
+
+        QuadVertex verts[4] =
+        {
+            { Float3( 0.5f, 0.5f, 0.0f) },
+            { Float3(-0.5f, 0.5f, 0.0f) },
+            { Float3( 0.5f,-0.5f, 0.0f) },
+            { Float3(-0.5f,-0.5f, 0.0f) },
+        };
+
+        D3D11_BUFFER_DESC bufferDesc;
+        ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+        bufferDesc.ByteWidth = sizeof(verts);
+        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        bufferDesc.CPUAccessFlags = 0;
+        D3D11_SUBRESOURCE_DATA initialData;
+        ZeroMemory(&initialData, sizeof(D3D11_SUBRESOURCE_DATA));
+        initialData.pSysMem = verts;
+        hr = m_pd3dDevice->CreateBuffer(&bufferDesc, &initialData, &m_pVertexBuffer);
+        if (FAILED(hr))
+            return false;
+
+        // Triangle #1: ACB
+        // Triangle #2: BCD
+        WORD indices[] = { 0, 2, 1, 1, 2, 3 };
+        m_numPolys = 2;
+
+        bufferDesc.ByteWidth = sizeof(indices);
+        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        bufferDesc.CPUAccessFlags = 0;
+        initialData.pSysMem = indices;
+        hr = m_pd3dDevice->CreateBuffer(&bufferDesc, &initialData, &m_pIndexBuffer);
+        if (FAILED(hr))
+            return false;
+
+        // Grown by DrawQuadInstances() when a frame has more quads
+        if (!CreateInstanceBuffer(256))
+            return false;
+
+        // Grown by DrawTextQuads() when a frame has more glyphs
+        if (!CreateTextBuffers(256))
+            return false;
+    }
+
+    D3D11_SAMPLER_DESC samplerDesc;
+    ZeroMemory(&samplerDesc, sizeof(D3D11_SAMPLER_DESC));
+    samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+    samplerDesc.MinLOD = 0;
+    samplerDesc.MaxLOD = D3D11_FLOAT32_MAX;
+    hr = m_pd3dDevice->CreateSamplerState(&samplerDesc, &m_pSamplerLinear);
+    if (FAILED(hr))
+        return false;
+
+    D3D11_BUFFER_DESC bufferDesc;
+    ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+    bufferDesc.ByteWidth = sizeof(ConstantBuffer_PerFrame);
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    hr = m_pd3dDevice->CreateBuffer(&bufferDesc, nullptr, &m_pcbPerFrame);
+    if (FAILED(hr))
+        return false;
+
+    return true;
+}
+
+void D3D11RenderBackend::Uninitialize()
+{
+    if (m_pd3dDeviceContext != nullptr)
+        m_pd3dDeviceContext->ClearState();
+
+    RELEASE_COM(m_pcbPerFrame);
+
+    RELEASE_COM(m_pSamplerLinear);
+    RELEASE_COM(m_pFontAtlasTextureRV);
+    RELEASE_COM(m_pTextIndexBuffer);
+    RELEASE_COM(m_pTextVertexBuffer);
+    m_textQuadCapacity = 0;
+
+    RELEASE_COM(m_pInstanceBuffer);
+    m_instanceCapacity = 0;
+    RELEASE_COM(m_pIndexBuffer);
+    RELEASE_COM(m_pVertexBuffer);
+
+    RELEASE_COM(m_pTextPixelShader);
+    RELEASE_COM(m_pTextVertexShader);
+    RELEASE_COM(m_pTextVertexLayout);
+
+    RELEASE_COM(m_pPixelShader);
+    RELEASE_COM(m_pVertexShader);
+    RELEASE_COM(m_pVertexLayout);
+
+    RELEASE_COM(m_pRenderTargetView);
+    RELEASE_COM(m_pDXGISwapChain);
+    RELEASE_COM(m_pd3dDeviceContext);
+    RELEASE_COM(m_pd3dDevice);
+}
+
+bool D3D11RenderBackend::LoadFontAtlasTexture(const uint8_t* pData, size_t size)
+{
+    HRESULT hr = CreateDDSTextureFromMemory(m_pd3dDevice, pData, size, nullptr, &m_pFontAtlasTextureRV);
+    if (FAILED(hr))
+        return false;
+
+    return true;
+}
+
+void D3D11RenderBackend::BeginFrame(const Float4x4& view, const Float4x4& projection)
+{
+    m_frameStats = RenderStats();
+
+    {
+        D3D11_MAPPED_SUBRESOURCE mappedResource;
+        ZeroMemory(&mappedResource, sizeof(D3D11_MAPPED_SUBRESOURCE));
+
+        m_pd3dDeviceContext->Map(m_pcbPerFrame, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+
+        // The shaders take column major matrices
+        Float4x4 transposedView = view.Transposed();
+        Float4x4 transposedProjection = projection.Transposed();
+
+        ConstantBuffer_PerFrame* pPerFrame = (ConstantBuffer_PerFrame*)mappedResource.pData;
+        memcpy(&pPerFrame->view, &transposedView, sizeof(pPerFrame->view));
+        memcpy(&pPerFrame->projection, &transposedProjection, sizeof(pPerFrame->projection));
+
+        m_pd3dDeviceContext->Unmap(m_pcbPerFrame, 0);
+
+        ++m_frameStats.uploads;
+        m_frameStats.bytesUploaded += sizeof(ConstantBuffer_PerFrame);
+    }
+
+    float clearColor[] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    m_pd3dDeviceContext->ClearRenderTargetView(m_pRenderTargetView, clearColor);
+
+    m_pd3dDeviceContext->RSSetViewports(1, &m_viewport);
+    m_pd3dDeviceContext->OMSetRenderTargets(1, &m_pRenderTargetView, nullptr);
+}
+
+void D3D11RenderBackend::EndFrame()
+{
+    m_pDXGISwapChain->Present(0, 0);
+}
+
+void D3D11RenderBackend::SetPass(RenderPass pass)
+{
+    m_pass = pass;
+    ++m_frameStats.stateChanges;
+
+    if (pass == RenderPass::Quads)
+    {
+        m_pd3dDeviceContext->IASetInputLayout(m_pVertexLayout);
+
+        m_pd3dDeviceContext->VSSetShader(m_pVertexShader, nullptr, 0);
+        m_pd3dDeviceContext->VSSetConstantBuffers(0, 1, &m_pcbPerFrame);
+        m_pd3dDeviceContext->PSSetShader(m_pPixelShader, nullptr, 0);
+
+        SetQuadVertexBuffers();
+        m_pd3dDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+    else
+    {
+        m_pd3dDeviceContext->IASetInputLayout(m_pTextVertexLayout);
+
+        m_pd3dDeviceContext->VSSetShader(m_pTextVertexShader, nullptr, 0);
+        m_pd3dDeviceContext->VSSetConstantBuffers(0, 1, &m_pcbPerFrame);
+        m_pd3dDeviceContext->PSSetShader(m_pTextPixelShader, nullptr, 0);
+        m_pd3dDeviceContext->PSSetShaderResources(0, 1, &m_pFontAtlasTextureRV);
+        m_pd3dDeviceContext->PSSetSamplers(0, 1, &m_pSamplerLinear);
+
+        SetTextVertexBuffers();
+        m_pd3dDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    }
+}
+
+void D3D11RenderBackend::DrawQuadInstances(const QuadInstance* pInstances, uint32_t count)
+{
+    assert(m_pass == RenderPass::Quads);
+
+    if (count == 0)
+        return;
+
+    if (count > m_instanceCapacity)
+    {
+        UINT capacity = (m_instanceCapacity > 0) ? m_instanceCapacity : 256;
+        while (capacity < count)
+            capacity *= 2;
+
+        if (!CreateInstanceBuffer(capacity))
+            return;
+
+        SetQuadVertexBuffers();
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    ZeroMemory(&mappedResource, sizeof(D3D11_MAPPED_SUBRESOURCE));
+
+    HRESULT hr = m_pd3dDeviceContext->Map(m_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+    if (FAILED(hr))
+        return;
+
+    memcpy(mappedResource.pData, pInstances, count * sizeof(QuadInstance));
+
+    m_pd3dDeviceContext->Unmap(m_pInstanceBuffer, 0);
+
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += count * sizeof(QuadInstance);
+
+    m_pd3dDeviceContext->DrawIndexedInstanced(m_numPolys * 3, count, 0, 0, 0);
+
+    ++m_frameStats.draws;
+    m_frameStats.instances += count;
+    m_frameStats.primitives += m_numPolys * count;
+}
+
+void D3D11RenderBackend::DrawTextQuads(const TextVertex* pVertices, uint32_t numQuads)
+{
+    assert(m_pass == RenderPass::Text);
+
+    if (numQuads == 0)
+        return;
+
+    if (numQuads > m_textQuadCapacity)
+    {
+        UINT capacity = (m_textQuadCapacity > 0) ? m_textQuadCapacity : 256;
+        while (capacity < numQuads)
+            capacity *= 2;
+
+        if (!CreateTextBuffers(capacity))
+            return;
+
+        SetTextVertexBuffers();
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    ZeroMemory(&mappedResource, sizeof(D3D11_MAPPED_SUBRESOURCE));
+
+    HRESULT hr = m_pd3dDeviceContext->Map(m_pTextVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+    if (FAILED(hr))
+        return;
+
+    memcpy(mappedResource.pData, pVertices, numQuads * 4 * sizeof(TextVertex));
+
+    m_pd3dDeviceContext->Unmap(m_pTextVertexBuffer, 0);
+
+    ++m_frameStats.uploads;
+    m_frameStats.bytesUploaded += numQuads * 4 * sizeof(TextVertex);
+
+    m_pd3dDeviceContext->DrawIndexed(numQuads * 6, 0, 0);
+
+    ++m_frameStats.draws;
+    m_frameStats.primitives += numQuads * 2;
+}
+
+bool D3D11RenderBackend::CreateInstanceBuffer(UINT capacity)
+{
+    RELEASE_COM(m_pInstanceBuffer);
+    m_instanceCapacity = 0;
+
+    D3D11_BUFFER_DESC bufferDesc;
+    ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+    bufferDesc.ByteWidth = capacity * sizeof(QuadInstance);
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    HRESULT hr = m_pd3dDevice->CreateBuffer(&bufferDesc, nullptr, &m_pInstanceBuffer);
+    if (FAILED(hr))
+        return false;
+
+    m_instanceCapacity = capacity;
+    return true;
+}
+
+bool D3D11RenderBackend::CreateTextBuffers(UINT quadCapacity)
+{
+    RELEASE_COM(m_pTextIndexBuffer);
+    RELEASE_COM(m_pTextVertexBuffer);
+    m_textQuadCapacity = 0;
+
+    // Written every frame
+    D3D11_BUFFER_DESC bufferDesc;
+    ZeroMemory(&bufferDesc, sizeof(D3D11_BUFFER_DESC));
+    bufferDesc.ByteWidth = quadCapacity * 4 * sizeof(TextVertex);
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    HRESULT hr = m_pd3dDevice->CreateBuffer(&bufferDesc, nullptr, &m_pTextVertexBuffer);
+    if (FAILED(hr))
+        return false;
+
+    // Never changes: every quad's vertices are split into the same two triangles as the quad pass' quad
+    std::vector<UINT> indices(quadCapacity * 6);
+    for (UINT quad = 0; quad < quadCapacity; ++quad)
+    {
+        UINT first = quad * 4;
+        UINT* pIndices = &indices[quad * 6];
+        pIndices[0] = first + 0;
+        pIndices[1] = first + 2;
+        pIndices[2] = first + 1;
+        pIndices[3] = first + 1;
+        pIndices[4] = first + 2;
+        pIndices[5] = first + 3;
+    }
+
+    bufferDesc.ByteWidth = (UINT)(indices.size() * sizeof(UINT));
+    bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    bufferDesc.CPUAccessFlags = 0;
+    D3D11_SUBRESOURCE_DATA initialData;
+    ZeroMemory(&initialData, sizeof(D3D11_SUBRESOURCE_DATA));
+    initialData.pSysMem = indices.data();
+    hr = m_pd3dDevice->CreateBuffer(&bufferDesc, &initialData, &m_pTextIndexBuffer);
+    if (FAILED(hr))
+        return false;
+
+    m_textQuadCapacity = quadCapacity;
+    return true;
+}
+
+void D3D11RenderBackend::SetQuadVertexBuffers()
+{
+    ID3D11Buffer* vertexBuffers[] = { m_pVertexBuffer, m_pInstanceBuffer };
+    UINT strides[] = { sizeof(QuadVertex), sizeof(QuadInstance) };
+    UINT offsets[] = { 0, 0 };
+    m_pd3dDeviceContext->IASetVertexBuffers(0, 2, vertexBuffers, strides, offsets);
+    m_pd3dDeviceContext->IASetIndexBuffer(m_pIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+}
+
+void D3D11RenderBackend::SetTextVertexBuffers()
+{
+    UINT stride = sizeof(TextVertex);
+    UINT offset = 0;
+    m_pd3dDeviceContext->IASetVertexBuffers(0, 1, &m_pTextVertexBuffer, &stride, &offset);
+    m_pd3dDeviceContext->IASetIndexBuffer(m_pTextIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Windows.h>
+#include <dxgi.h>
+#include <d3d11.h>
+#include <d3dcompiler.h>
+#include "DDSTextureLoader11.h"
+#include <DirectXMath.h>
+#include "Assets/AssetPack.h"
+#include "Render/RenderBackend.h"
+
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "d3dcompiler.lib")
+
+struct ConstantBuffer_PerFrame
+{
+    DirectX::XMFLOAT4X4 view;
+    DirectX::XMFLOAT4X4 projection;
+};
+
+class D3D11RenderBackend : public RenderBackend
+{
+    ID3D11Device*           m_pd3dDevice;
+    ID3D11DeviceContext*    m_pd3dDeviceContext;
+    IDXGISwapChain*         m_pDXGISwapChain;
+    ID3D11RenderTargetView* m_pRenderTargetView;
+    D3D11_VIEWPORT          m_viewport;
+
+    ID3D11InputLayout*      m_pVertexLayout;
+    ID3D11VertexShader*     m_pVertexShader;
+    ID3D11PixelShader*      m_pPixelShader;
+    
+    ID3D11InputLayout*      m_pTextVertexLayout;
+    ID3D11VertexShader*     m_pTextVertexShader;
+    ID3D11PixelShader*      m_pTextPixelShader;
+
+    UINT                    m_numPolys;
+    ID3D11Buffer*           m_pVertexBuffer;
+    ID3D11Buffer*           m_pIndexBuffer;
+    ID3D11Buffer*           m_pInstanceBuffer;
+    UINT                    m_instanceCapacity;
+
+    ID3D11Buffer*           m_pTextVertexBuffer;
+    ID3D11Buffer*           m_pTextIndexBuffer;
+    UINT                    m_textQuadCapacity;
+    ID3D11ShaderResourceView* m_pFontAtlasTextureRV;
+    ID3D11SamplerState*     m_pSamplerLinear;
+
+    ID3D11Buffer*           m_pcbPerFrame;
+
+    RenderPass              m_pass;
+
+    UINT                    m_numShadersCompiled;
+    UINT                    m_numShadersCached;
+
+public:
+    D3D11RenderBackend();
+    ~D3D11RenderBackend();
+
+    // The shader sources are read from the asset pack
+    bool Initialize(HWND hwnd, const AssetPack& assets);
+    void Uninitialize();
+
+    // Compiles the shaders whose cache files are missing or stale, without creating a device. Run as a
+    // build step, so the game starts from the cache.
+    static bool BuildShaderCache(const AssetPack& assets);
+
+    // How Initialize() got its shaders
+    UINT GetNumShadersCompiled() const { return m_numShadersCompiled; }
+    UINT GetNumShadersCached() const { return m_numShadersCached; }
+
+    float GetWidth() const override { return m_viewport.Width; }
+    float GetHeight() const override { return m_viewport.Height; }
+
+    bool LoadFontAtlasTexture(const uint8_t* pData, size_t size) override;
+
+    void BeginFrame(const Float4x4& view, const Float4x4& projection) override;
+    void EndFrame() override;
+
+    void SetPass(RenderPass pass) override;
+    void DrawQuadInstances(const QuadInstance* pInstances, uint32_t count) override;
+    void DrawTextQuads(const TextVertex* pVertices, uint32_t numQuads) override;
+
+private:
+    bool CreateInstanceBuffer(UINT capacity);
+    bool CreateTextBuffers(UINT quadCapacity);
+
+    void SetQuadVertexBuffers();
+    void SetTextVertexBuffers();
+};
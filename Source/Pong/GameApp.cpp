@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
 #include <cmath>
 #include <cassert>
 #include <new>
@@ -7,10 +8,24 @@
 #include "GameApp.h"
 #include "Debugging/Logger.h"
 
-using namespace DirectX;
+#pragma comment(lib, "winmm.lib")
 
 GameApp* g_pApp = nullptr;
 
+enum PlayerInputFlags : uint32_t
+{
+    PlayerInput_Up      = 1 << 0,
+    PlayerInput_Down    = 1 << 1,
+    PlayerInput_Start   = 1 << 2,
+};
+
+static const char* AssetPackFilename = "Data/Assets.pack";
+
+static double GetTimeSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 GameApp::GameApp()
 {
     g_pApp		            = this;
@@ -20,31 +35,63 @@ GameApp::GameApp()
     ZeroMemory(&m_rcclient, sizeof(RECT));
     m_hwnd		            = nullptr;
 
+    m_pLoader               = nullptr;
+    m_wallHitWave           = WaveFile();
+    m_paddleHitWave         = WaveFile();
+    m_startTime             = 0.0;
+
+    m_pRenderBackend        = nullptr;
+    m_nullRendering         = false;
+
+    m_pJobs                 = nullptr;
+
     ZeroMemory(&m_key, sizeof(m_key));
+    m_playerInput           = 0;
+
+    m_tick                  = 0;
+    m_ai                    = PaddleAI(1, PaddleAIDifficulty::Medium(), (uint32_t)GetTickCount());
+    m_match.SetEventQueue(&m_events);
 
-    m_state                 = GameState::Initializing;
-    m_worldBounds           = XMFLOAT2(0.0f, 0.0f);
-    m_paddleScore1          = 0;
-    m_paddleScore2          = 0;
+    m_threadedSimulation    = false;
+    m_stopSimulation        = false;
 }
 
 bool GameApp::Initialize()
 {
+    m_startTime = GetTimeSeconds();
+
     if (!InitWindow())
         return false;
 
-    if (!m_renderer.Initialize(m_hwnd))
+    m_pJobs = new (std::nothrow) JobSystem();
+    if (m_pJobs == nullptr)
         return false;
-    if (!m_renderer.LoadFontMetaData())
+
+    // Every asset is used in place from the one mapped pack
+    if (!m_assets.Open(AssetPackFilename))
+    {
+        LOG("GameApp", Error, "Can't open %s", AssetPackFilename);
         return false;
+    }
 
-    if (!m_audio.Initialize(m_hwnd))
+#ifdef _DEBUG
+    if (!m_assets.Verify())
+    {
+        LOG("GameApp", Error, "%s is damaged", AssetPackFilename);
         return false;
-    if (!m_audio.LoadSound("Data/WallHit.wav", SoundEvent::WallHit))
+    }
+#endif
+
+    // Only the devices are created up front; the assets stream in while Run() draws the loading screen
+    if (!CreateRenderBackend() || !m_audio.Initialize(m_hwnd))
         return false;
-    if (!m_audio.LoadSound("Data/PaddleHit.wav", SoundEvent::PaddleHit))
+
+    if (!StartLoading())
         return false;
 
+    // Both paddles are recorded: the AI's decisions depend on its random seed and difficulty, which the replay doesn't store
+    m_replay.Begin(m_match.GetRules(), Real(m_timestep.GetStepSeconds()), 0x3);
+
     return true;
 }
 
@@ -53,6 +100,17 @@ void GameApp::Run()
     if (!IsWindowVisible(m_hwnd))
         ShowWindow(m_hwnd, SW_SHOW);
 
+    if (!FinishLoading())
+        return;
+
+    PublishFrame();
+
+    if (m_threadedSimulation)
+    {
+        m_stopSimulation = false;
+        m_simulationThread = std::thread(&GameApp::SimulationThread, this);
+    }
+
     std::chrono::high_resolution_clock::time_point lastTime =
         std::chrono::high_resolution_clock::now();
 
@@ -72,12 +130,38 @@ void GameApp::Run()
             auto duration = std::chrono::duration<float>(currentTime - lastTime);
             lastTime = currentTime;
 
-            float deltaTime = duration.count();
-            Update(deltaTime);
+            float alpha;
+            if (m_threadedSimulation)
+            {
+                // Draw the newest state the simulation thread has published, blending towards it over one tick
+                m_frames.Update();
+                double sinceStep = GetTimeSeconds() - m_frames.GetReadBuffer().time;
+                alpha = std::min(std::max((float)(sinceStep / m_timestep.GetStepSeconds()), 0.0f), 1.0f);
+            }
+            else
+            {
+                Simulate(duration.count());
+                m_frames.Update();
+                alpha = m_timestep.GetAlpha();
+            }
 
-            Render();
+            ProcessEvents();
+
+            const MatchFrame& frame = m_frames.GetReadBuffer();
+            Render(frame, alpha);
+
+            // Every published frame carries the state, so the end of the match can't be missed the way
+            // an event dropped from a full queue can
+            if (frame.over)
+                break;
         }
     }
+
+    if (m_simulationThread.joinable())
+    {
+        m_stopSimulation = true;
+        m_simulationThread.join();
+    }
 }
 
 LRESULT GameApp::StaticMsgProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
@@ -95,10 +179,12 @@ LRESULT GameApp::MsgProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
         case WM_KEYDOWN:
             m_key[BYTE(wParam)] = true;
+            UpdatePlayerInput();
             break;
 
         case WM_KEYUP:
             m_key[BYTE(wParam)] = false;
+            UpdatePlayerInput();
             break;
 
         default:
@@ -110,8 +196,43 @@ LRESULT GameApp::MsgProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 
 void GameApp::Uninitialize()
 {
+    if (m_replay.GetNumTicks() > 0)
+    {
+        m_replay.End(m_match);
+        if (!SaveReplay("Replays.archive"))
+            LOG("GameApp", Warning, "Failed to save the replay\n");
+    }
+
+    const RenderTimings& timings = m_renderer.GetTimings();
+    if (timings.frames > 0 && m_pRenderBackend != nullptr)
+    {
+        const RenderStats& stats = m_pRenderBackend->GetFrameStats();
+        LOG("GameApp", Info, "%llu frames rendered: %.1f us submitting, %.1f us per frame on average (%.1f us at most), %u draws and %u uploads in the last one",
+            (unsigned long long)timings.frames, timings.totalSubmitSeconds / timings.frames * 1e6, timings.totalFrameSeconds / timings.frames * 1e6,
+            timings.maxFrameSeconds * 1e6, stats.draws, stats.uploads);
+    }
+
+    // Its jobs may still be decoding into the renderer and the audio
+    if (m_pLoader != nullptr)
+    {
+        delete m_pLoader;
+        m_pLoader = nullptr;
+    }
+
     m_audio.Uninitialize();
     m_renderer.Uninitialize();
+
+    if (m_pRenderBackend != nullptr)
+    {
+        delete m_pRenderBackend;
+        m_pRenderBackend = nullptr;
+    }
+
+    if (m_pJobs != nullptr)
+    {
+        delete m_pJobs;
+        m_pJobs = nullptr;
+    }
 }
 
 bool GameApp::InitWindow()
@@ -147,276 +268,283 @@ bool GameApp::InitWindow()
     return true;
 }
 
-void GameApp::ChangeState(GameState newState)
+bool GameApp::CreateRenderBackend()
 {
-    switch (newState)
+    if (m_nullRendering)
+    {
+        m_pRenderBackend = new (std::nothrow) NullRenderBackend((float)m_rcclient.right, (float)m_rcclient.bottom);
+    }
+    else
     {
-        case GameState::LoadingGameEnvironment:
+        D3D11RenderBackend* pD3D11Backend = new (std::nothrow) D3D11RenderBackend();
+        m_pRenderBackend = pD3D11Backend;
+        if (pD3D11Backend != nullptr && !pD3D11Backend->Initialize(m_hwnd, m_assets))
+            return false;
+
+        if (pD3D11Backend != nullptr)
         {
-            m_worldBounds.x = 640.0f;
-            m_worldBounds.y = 480.0f;
-
-            m_paddles[0].pos.x = m_worldBounds.x * 0.05f;
-            m_paddles[0].pos.y = m_worldBounds.y / 2.0f;
-            m_paddles[0].scale.x = 10.0f;
-            m_paddles[0].scale.y = 60.0f;
-            m_paddles[0].bounds.min.x = m_paddles[0].pos.x - (m_paddles[0].scale.x / 2.0f);
-            m_paddles[0].bounds.min.y = m_paddles[0].pos.y - (m_paddles[0].scale.y / 2.0f);
-            m_paddles[0].bounds.max.x = m_paddles[0].pos.x + (m_paddles[0].scale.x / 2.0f);
-            m_paddles[0].bounds.max.y = m_paddles[0].pos.y + (m_paddles[0].scale.y / 2.0f);
-
-            m_paddles[1].pos.x = m_worldBounds.x * 0.95f;
-            m_paddles[1].pos.y = m_worldBounds.y / 2.0f;
-            m_paddles[1].scale.x = 10.0f;
-            m_paddles[1].scale.y = 60.0f;
-            m_paddles[1].bounds.min.x = m_paddles[1].pos.x - (m_paddles[1].scale.x / 2.0f);
-            m_paddles[1].bounds.min.y = m_paddles[1].pos.y - (m_paddles[1].scale.y / 2.0f);
-            m_paddles[1].bounds.max.x = m_paddles[1].pos.x + (m_paddles[1].scale.x / 2.0f);
-            m_paddles[1].bounds.max.y = m_paddles[1].pos.y + (m_paddles[1].scale.y / 2.0f);
-
-            m_ball.pos.x = m_worldBounds.x / 2.0f;
-            m_ball.pos.y = m_worldBounds.y / 2.0f;
-            m_ball.scale.x = 10.0f;
-            m_ball.scale.y = 10.0f;
-            m_ball.velocity.x = -350.0f;
-            m_ball.velocity.y = 300.0f;
-            m_ball.bounds.min.x = m_ball.pos.x - (m_ball.scale.x / 2.0f);
-            m_ball.bounds.min.y = m_ball.pos.y - (m_ball.scale.y / 2.0f);
-            m_ball.bounds.max.x = m_ball.pos.x + (m_ball.scale.x / 2.0f);
-            m_ball.bounds.max.y = m_ball.pos.y + (m_ball.scale.y / 2.0f);
-
-            ChangeState(GameState::WaitingForPlayers);
-            return;
+            LOG("GameApp", Info, "%u shaders loaded from the cache, %u compiled",
+                pD3D11Backend->GetNumShadersCached(), pD3D11Backend->GetNumShadersCompiled());
         }
     }
 
-    m_state = newState;
+    if (m_pRenderBackend == nullptr)
+        return false;
+
+    m_renderer.Initialize(m_pRenderBackend);
+
+    return true;
 }
 
-void GameApp::Update(float deltaTime)
-{  
-    switch (m_state)
-    {        
-        case GameState::Initializing:
-            ChangeState(GameState::LoadingGameEnvironment);
-            break;
+bool GameApp::StartLoading()
+{
+    m_pLoader = new (std::nothrow) AssetLoader(m_pJobs, &m_assets);
+    if (m_pLoader == nullptr)
+        return false;
 
-        case GameState::LoadingGameEnvironment:
-            break;
+    // The glyph tables are checked on a worker, but handed to the renderer here, as it reads them while drawing
+    bool added = m_pLoader->Add("FontAtlas.font",
+        [this](const uint8_t* pData, size_t size) { return m_loadedFontAtlas.Open(pData, size); },
+        [this]() { m_renderer.SetFontAtlas(std::move(m_loadedFontAtlas)); return true; });
+
+    // The device is free threaded, so the texture is created on the worker. Nothing uses it before the
+    // loading is done, as the loading screen draws no text.
+    added = added && m_pLoader->Add("FontAtlas.dds",
+        [this](const uint8_t* pData, size_t size) { return m_pRenderBackend->LoadFontAtlasTexture(pData, size); });
+
+    // The sound buffers belong to this thread's DirectSound object
+    added = added && m_pLoader->Add("WallHit.wav",
+        [this](const uint8_t* pData, size_t size) { return ReadWaveFile(std::span<const uint8_t>(pData, size), m_wallHitWave); },
+        [this]() { return m_audio.AddSound(m_wallHitWave, SoundEvent::WallHit); });
+    added = added && m_pLoader->Add("PaddleHit.wav",
+        [this](const uint8_t* pData, size_t size) { return ReadWaveFile(std::span<const uint8_t>(pData, size), m_paddleHitWave); },
+        [this]() { return m_audio.AddSound(m_paddleHitWave, SoundEvent::PaddleHit); });
+
+    if (!added)
+    {
+        LOG("GameApp", Error, "%s is missing assets", AssetPackFilename);
+        return false;
+    }
 
-        case GameState::WaitingForPlayers:
-        {
-            if (m_key[' '])
-                ChangeState(GameState::Running);
+    m_pLoader->Start();
 
-            if (m_paddleScore1 >= 5 || m_paddleScore2 >= 5)
-            {
-                PostQuitMessage(0);
-            }
+    return true;
+}
 
-            break;
-        }
+bool GameApp::FinishLoading()
+{
+    uint32_t numLoadingFrames = 0;
 
-        case GameState::Running:
+    MSG msg;
+    ZeroMemory(&msg, sizeof(MSG));
+    while (!m_pLoader->IsDone())
+    {
+        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
         {
-            // Set paddle 1's velocity based on player input
-            if (m_key['W'])
-            {
-                m_paddles[0].velocity.y = 300.0f;
-            }
-            else if (m_key['S'])
-            {
-                m_paddles[0].velocity.y = -300.0f;
-            }
-            else
-            {
-                m_paddles[0].velocity.y = 0.0f;
-            }
+            // Closed while loading
+            if (msg.message == WM_QUIT)
+                return false;
 
-            // Set paddle 2's velocity based on AI logic
-            if (m_paddles[1].pos.y < m_ball.pos.y)
-            {
-                m_paddles[1].velocity.y = 290.0f;
-            }
-            else if (m_paddles[1].pos.y > m_ball.pos.y)
-            {
-                m_paddles[1].velocity.y = -290.0f;
-            }
-            else
-            {
-                m_paddles[1].velocity.y = 0.0f;
-            }
-
-            for (size_t i = 0; i < ARRAYSIZE(m_paddles); ++i)
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+        else
+        {
+            if (!m_pLoader->Update())
             {
-                UpdatePaddle(m_paddles[i].pos, m_paddles[i].scale, m_paddles[i].velocity, m_paddles[i].bounds, deltaTime); 
+                LOG("GameApp", Error, "Failed to load %s", m_pLoader->GetFailedAsset());
+                return false;
             }
 
-            UpdateBall(m_ball.pos, m_ball.scale, m_ball.velocity, m_ball.bounds, m_paddles, ARRAYSIZE(m_paddles), deltaTime);
+            RenderLoading(m_pLoader->GetProgress());
 
-            break;
+            if (++numLoadingFrames == 1)
+                LOG("GameApp", Info, "First frame after %.1f ms", (GetTimeSeconds() - m_startTime) * 1000.0);
         }
-
-        default:
-            assert(false && "Unrecognized state");
     }
+
+    LOG("GameApp", Info, "Assets loaded after %.1f ms, %u loading frames drawn", (GetTimeSeconds() - m_startTime) * 1000.0,
+        numLoadingFrames);
+
+    delete m_pLoader;
+    m_pLoader = nullptr;
+
+    return true;
 }
 
-void GameApp::UpdatePaddle(DirectX::XMFLOAT2& pos, const DirectX::XMFLOAT2& scale, 
-    DirectX::XMFLOAT2& velocity, BoundingBox& bounds, float deltaTime)
+bool GameApp::SaveReplay(const char* pArchiveFilename)
 {
-    pos.x += velocity.x * deltaTime;
-    pos.y += velocity.y * deltaTime;
+    ReplayArchiveWriter archive;
+    if (!archive.Open(pArchiveFilename))
+        return false;
 
-    bounds.min.x = pos.x - (scale.x / 2.0f);
-    bounds.min.y = pos.y - (scale.y / 2.0f);
-    bounds.max.x = pos.x + (scale.x / 2.0f);
-    bounds.max.y = pos.y + (scale.y / 2.0f);
+    const std::vector<uint8_t>& data = m_replay.GetData();
+    bool appended = archive.Append(archive.GetNextMatchId(), data.data(), data.size());
 
-    // Clamp the paddle's Y position to ensure it stays within the top and bottom edges of the world bounds
-    if (pos.y + (scale.y / 2.0f) > m_worldBounds.y)
+    return archive.Close() && appended;
+}
+
+void GameApp::UpdatePlayerInput()
+{
+    uint32_t input = 0;
+    if (m_key['W'])
+        input |= PlayerInput_Up;
+    if (m_key['S'])
+        input |= PlayerInput_Down;
+    if (m_key[' '])
+        input |= PlayerInput_Start;
+
+    m_playerInput.store(input, std::memory_order_relaxed);
+}
+
+void GameApp::Simulate(double elapsedSeconds)
+{
+    // Simulate in fixed size steps, so the outcome does not depend on the frame rate
+    int numSteps = m_timestep.Advance(elapsedSeconds);
+    for (int i = 0; i < numSteps; ++i)
     {
-        pos.y = m_worldBounds.y - (scale.y / 2.0f);
+        m_previousMatch = m_match;
+        Update(m_timestep.GetStepSeconds());
     }
-    else if (pos.y - (scale.y / 2.0f) < 0.0f)
+
+    if (numSteps > 0)
+        PublishFrame();
+}
+
+void GameApp::SimulationThread()
+{
+    // The default timer resolution (~15ms) is too coarse to sleep until the next tick
+    timeBeginPeriod(1);
+
+    double lastTime = GetTimeSeconds();
+    while (!m_stopSimulation)
     {
-        pos.y = (scale.y / 2.0f);
+        double currentTime = GetTimeSeconds();
+        Simulate(currentTime - lastTime);
+        lastTime = currentTime;
+
+        // Sleep until the next tick is due
+        double untilNextStep = (1.0 - m_timestep.GetAlpha()) * m_timestep.GetStepSeconds();
+        if (untilNextStep > 0.001)
+            std::this_thread::sleep_for(std::chrono::duration<double>(untilNextStep - 0.001));
+        else
+            std::this_thread::yield();
     }
+
+    timeEndPeriod(1);
 }
 
-void GameApp::UpdateBall(DirectX::XMFLOAT2& pos, const DirectX::XMFLOAT2& scale, DirectX::XMFLOAT2& velocity, 
-    BoundingBox& bounds, Paddle* paddles, size_t numPaddles, float deltaTime)
+void GameApp::Update(float deltaTime)
 {
-    pos.x += velocity.x * deltaTime;
-    pos.y += velocity.y * deltaTime;
+    uint32_t playerInput = m_playerInput.load(std::memory_order_relaxed);
 
-    bounds.min.x = pos.x - (scale.x / 2.0f);
-    bounds.min.y = pos.y - (scale.y / 2.0f);
-    bounds.max.x = pos.x + (scale.x / 2.0f);
-    bounds.max.y = pos.y + (scale.y / 2.0f);
+    MatchInput input;
+    input.start = (playerInput & PlayerInput_Start) != 0;
 
-    // Bounce the ball off the top and bottom edges of the world bounds
-    if (pos.y + (scale.y / 2.0f) > m_worldBounds.y)
-    {
-        float penY = (pos.y + (scale.y / 2.0f)) - m_worldBounds.y; // Penetration depth along the Y-axis
-        pos.y -= penY;
+    // Set paddle 1's action based on player input
+    if (playerInput & PlayerInput_Up)
+        input.paddles[0] = PaddleAction::Up;
+    else if (playerInput & PlayerInput_Down)
+        input.paddles[0] = PaddleAction::Down;
 
-        bounds.min.x -= penY;
-        bounds.min.y -= penY;
-        bounds.max.x -= penY;
-        bounds.max.y -= penY;
+    // Set paddle 2's action based on AI logic
+    input.paddles[1] = m_ai.Decide(m_match, Real(deltaTime));
 
-        velocity.y = -velocity.y;
-        m_audio.Play(SoundEvent::WallHit);
-    }
-    else if (pos.y + (scale.y / 2.0f) < 0.0f)
-    {
-        float penY = 0.0f - (pos.y - (scale.y / 2.0f)); // Penetration depth along the Y-axis
-        pos.y += penY;
+    m_replay.RecordTick(input, m_match);
+    m_match.Step(input, deltaTime);
+    ++m_tick;
+}
 
-        bounds.min.x += penY;
-        bounds.min.y += penY;
-        bounds.max.x += penY;
-        bounds.max.y += penY;
+void GameApp::PublishFrame()
+{
+    MatchFrame& frame = m_frames.GetWriteBuffer();
+    frame.Capture(m_previousMatch, m_match);
+    frame.tick = m_tick;
+    frame.time = GetTimeSeconds();
 
-        velocity.y = -velocity.y;
-        m_audio.Play(SoundEvent::WallHit);
-    }
+    m_frames.Publish();
+}
 
-    // Bounce the ball off the left and right paddles
-    for (size_t i = 0; i < numPaddles; ++i)
+void GameApp::ProcessEvents()
+{
+    GameEvent event;
+    while (m_events.TryPop(event))
     {
-        const Paddle& paddle = paddles[i];
-        if (bounds.Intersects(paddle.bounds))
+        switch (event.type)
         {
-            XMFLOAT2 penetration;
-
-            XMFLOAT2 overlap;
-            overlap.x = std::min(bounds.max.x, paddle.bounds.max.x) - std::max(bounds.min.x, paddle.bounds.min.x);
-            overlap.y = std::min(bounds.max.y, paddle.bounds.max.y) - std::max(bounds.min.y, paddle.bounds.min.y);
-            if (overlap.x > 0.0f && overlap.y > 0.0f)
-            {
-                // Resolve along the axis of least penetration
-                if (overlap.x < overlap.y)
-                {
-                    float direction = (bounds.min.x + bounds.max.x < paddle.bounds.min.x + paddle.bounds.max.x) ? -1.0f : 1.0f;
-                    penetration.x = direction * overlap.x;
-                    penetration.y = 0.0f;
-                }
-                else
-                {
-                    float direction = (bounds.min.y + bounds.max.y < paddle.bounds.min.y + paddle.bounds.max.y) ? -1.0f : 1.0f;
-                    penetration.x = 0.0f;
-                    penetration.y = direction * overlap.y;
-                }
-            }
-            else
-            {
-                penetration.x = 0.0f;
-                penetration.y = 0.0f;
-            }
-
-            pos.x += penetration.x;
-            pos.y += penetration.y;
+            case GameEventType::WallHit:
+                m_audio.Play(SoundEvent::WallHit);
+                break;
 
-            bounds.min.x += penetration.x;
-            bounds.min.y += penetration.y;
-            bounds.max.x += penetration.x;
-            bounds.max.y += penetration.y;
+            case GameEventType::PaddleHit:
+                m_audio.Play(SoundEvent::PaddleHit);
+                break;
 
-            velocity.x = -velocity.x;
-            m_audio.Play(SoundEvent::PaddleHit);
+            default:
+                break;
         }
     }
+}
 
-    // Check if the ball has passed beyond the left or right edge — update the score accordingly
-    if (pos.x < 0.0f)
-    {
-        ++m_paddleScore2;
-        ChangeState(GameState::LoadingGameEnvironment);
-    }
-    else if (pos.x > m_worldBounds.x)
-    {
-        ++m_paddleScore1;
-        ChangeState(GameState::LoadingGameEnvironment);
-    }
+void GameApp::RenderLoading(float progress)
+{
+    m_renderer.PreRender();
+
+    // A bar across the middle of the screen, filling from the left
+    float width = m_pRenderBackend->GetWidth();
+    float height = m_pRenderBackend->GetHeight();
+    float barWidth = std::max(width * 0.6f * progress, 1.0f);
+
+    m_renderer.PrepareQuadPass();
+    m_renderer.RenderQuad(Float2(width * 0.2f + barWidth * 0.5f, height * 0.5f), Float2(barWidth, 8.0f));
+
+    m_renderer.PostRender();
 }
 
-void GameApp::Render()
+void GameApp::Render(const MatchFrame& frame, float alpha)
 {
     m_renderer.PreRender();
 
+    Float2 worldBounds(ToFloat(frame.worldBounds.x), ToFloat(frame.worldBounds.y));
+
+    // Blend between the previous and the current step. Don't blend across a state change (e.g. the ball being
+    // put back to the center after a point), as that would draw the ball sweeping across the field.
+    if (frame.stateChanged)
+        alpha = 1.0f;
+
     // Render the ball and the paddles:
     m_renderer.PrepareQuadPass();
     {
-        for (size_t i = 0; i < ARRAYSIZE(m_paddles); ++i)
+        for (size_t i = 0; i < Match::NumPaddles; ++i)
         {
-            m_renderer.RenderQuad(m_paddles[i].pos, m_paddles[i].scale);
+            const Paddle& paddle = frame.paddles[i];
+            Vec2 pos = Lerp(frame.previousPaddlePos[i], paddle.pos, alpha);
+            m_renderer.RenderQuad(Float2(ToFloat(pos.x), ToFloat(pos.y)), Float2(ToFloat(paddle.scale.x), ToFloat(paddle.scale.y)));
         }
 
-        m_renderer.RenderQuad(m_ball.pos, m_ball.scale);
+        const Ball& ball = frame.ball;
+        Vec2 pos = Lerp(frame.previousBallPos, ball.pos, alpha);
+        m_renderer.RenderQuad(Float2(ToFloat(pos.x), ToFloat(pos.y)), Float2(ToFloat(ball.scale.x), ToFloat(ball.scale.y)));
     }
 
     // Render texts:
     m_renderer.PrepareTextPass();
     {
+        char score[16];
+        snprintf(score, sizeof(score), "%d", frame.paddleScore1);
+        m_renderer.UpdateTextRun(m_scoreTexts[0], score, Float2(worldBounds.x * 0.3f, worldBounds.y * 0.8f), 48.0f);
+        m_renderer.RenderTextRun(m_scoreTexts[0]);
 
-        m_renderer.RenderText(std::to_string(m_paddleScore1), XMFLOAT2(m_worldBounds.x * 0.3f, m_worldBounds.y * 0.8f), 48.0f);
-        m_renderer.RenderText(std::to_string(m_paddleScore2), XMFLOAT2(m_worldBounds.x * 0.6f, m_worldBounds.y * 0.8f), 48.0f);
+        snprintf(score, sizeof(score), "%d", frame.paddleScore2);
+        m_renderer.UpdateTextRun(m_scoreTexts[1], score, Float2(worldBounds.x * 0.6f, worldBounds.y * 0.8f), 48.0f);
+        m_renderer.RenderTextRun(m_scoreTexts[1]);
 
-        if (m_state != GameState::Running)
-            m_renderer.RenderText("Press SPACE to start", XMFLOAT2(m_worldBounds.x * 0.2f, m_worldBounds.y * 0.6f), 12.0f);
+        if (frame.state != GameState::Running)
+        {
+            m_renderer.UpdateTextRun(m_promptText, "Press SPACE to start", Float2(worldBounds.x * 0.2f, worldBounds.y * 0.6f), 12.0f);
+            m_renderer.RenderTextRun(m_promptText);
+        }
     }
 
     m_renderer.PostRender();
 }
-
-bool BoundingBox::Intersects(const BoundingBox& box) const
-{
-    return (
-        max.x > box.min.x &&
-        min.x < box.max.x &&
-        max.y > box.min.y &&
-        min.y < box.max.y
-        );
-}   
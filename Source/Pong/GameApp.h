@@ -2,50 +2,22 @@
 
 #define NOMINMAX
 #include <Windows.h>
-#include <DirectXMath.h>
-#include "Renderer.h"
+#include <atomic>
+#include <thread>
+#include "D3D11RenderBackend.h"
 #include "Audio.h"
-
-enum class GameState
-{
-    Invalid = 0,
-    Initializing,
-    LoadingGameEnvironment,
-    WaitingForPlayers,
-    Running,
-};
-
-struct BoundingBox
-{
-    DirectX::XMFLOAT2 min;
-    DirectX::XMFLOAT2 max;
-
-    BoundingBox() { ZeroMemory(this, sizeof(BoundingBox)); }
-
-    bool Intersects(const BoundingBox& box) const;
-};
-
-struct Ball
-{
-    DirectX::XMFLOAT2   pos;
-    DirectX::XMFLOAT2   scale;
-
-    DirectX::XMFLOAT2   velocity;
-    BoundingBox         bounds;
-
-    Ball() { ZeroMemory(this, sizeof(Ball)); }
-};
-
-struct Paddle
-{
-    DirectX::XMFLOAT2   pos;
-    DirectX::XMFLOAT2   scale;
-
-    DirectX::XMFLOAT2   velocity;
-    BoundingBox         bounds;
-
-    Paddle() { ZeroMemory(this, sizeof(Paddle)); }
-};
+#include "Render/Renderer.h"
+#include "Render/NullRenderBackend.h"
+#include "Simulation/Match.h"
+#include "Simulation/FixedTimestep.h"
+#include "Simulation/MatchFrame.h"
+#include "AI/PaddleAI.h"
+#include "Threading/TripleBuffer.h"
+#include "Threading/JobSystem.h"
+#include "Replay/Replay.h"
+#include "Replay/ReplayArchive.h"
+#include "Assets/AssetPack.h"
+#include "Assets/AssetLoader.h"
 
 class GameApp
 {
@@ -54,21 +26,53 @@ class GameApp
     RECT                    m_rcclient;
     HWND                    m_hwnd;
 
+    AssetPack               m_assets;           // Mapped for the whole run, the font and sounds point into it
+    AssetLoader*            m_pLoader;          // Streams the assets in while Run() draws the loading screen
+    FontAtlas               m_loadedFontAtlas;  // Decoded by the loader, handed to the renderer once finalized
+    WaveFile                m_wallHitWave;
+    WaveFile                m_paddleHitWave;
+    double                  m_startTime;        // When Initialize() was called, for the time to the first frame
+
+    RenderBackend*          m_pRenderBackend;
+    bool                    m_nullRendering;
     Renderer                m_renderer;
+    TextRun                 m_scoreTexts[2];    // Laid out again only when a score changes
+    TextRun                 m_promptText;
     Audio                   m_audio;
 
+    JobSystem*              m_pJobs;
+
     bool                    m_key[256];
+    std::atomic<uint32_t>   m_playerInput;      // PlayerInput flags, from the window thread to the simulation
+
+    FixedTimestep           m_timestep;
+    Match                   m_match;
+    Match                   m_previousMatch;    // State before the last step, used to interpolate rendering
+    uint64_t                m_tick;
+    PaddleAI                m_ai;               // Plays paddle 2
+    GameEventQueue          m_events;           // Filled by m_match, drained once per frame
+    TripleBuffer<MatchFrame> m_frames;          // Latest simulated state, from the simulation to rendering
 
-    GameState               m_state;
-    DirectX::XMFLOAT2       m_worldBounds;
-    Paddle                  m_paddles[2];
-    Ball                    m_ball;
-    int                     m_paddleScore1;
-    int                     m_paddleScore2;
+    bool                    m_threadedSimulation;
+    std::thread             m_simulationThread;
+    std::atomic<bool>       m_stopSimulation;
+
+    ReplayWriter            m_replay;           // Records the match; appended to Replays.archive on exit
 
 public:
     GameApp();
 
+    // Simulation ticks per second (e.g. 120, 240 or 1000). Rendering interpolates between ticks.
+    void SetTickRate(int tickRate) { m_timestep.SetTickRate(tickRate); }
+
+    void SetAIDifficulty(const PaddleAIDifficulty& difficulty) { m_ai.SetDifficulty(difficulty); }
+
+    // Run the simulation on its own thread, so slow frames (e.g. a stalled Present) don't delay it
+    void SetThreadedSimulation(bool threaded) { m_threadedSimulation = threaded; }
+
+    // Draw through NullRenderBackend instead of D3D11: nothing is shown, but the game runs without a GPU
+    void SetNullRendering(bool nullRendering) { m_nullRendering = nullRendering; }
+
     bool Initialize();
     void Run();
 
@@ -79,16 +83,22 @@ public:
 
 private:
     bool InitWindow();
+    bool CreateRenderBackend();
+    bool StartLoading();
+    bool FinishLoading();
+
+    bool SaveReplay(const char* pArchiveFilename);
 
-    void ChangeState(GameState newState);
+    void UpdatePlayerInput();
 
+    void Simulate(double elapsedSeconds);
+    void SimulationThread();
     void Update(float deltaTime);
-    void UpdatePaddle(DirectX::XMFLOAT2& pos, const DirectX::XMFLOAT2& scale, 
-        DirectX::XMFLOAT2& velocity, BoundingBox& bounds, float deltaTime);
-    void UpdateBall(DirectX::XMFLOAT2& pos, const DirectX::XMFLOAT2& scale, DirectX::XMFLOAT2& velocity, 
-        BoundingBox& bounds, Paddle* paddles, size_t numPaddles, float deltaTime);
+    void PublishFrame();
+    void ProcessEvents();
 
-    void Render();
+    void RenderLoading(float progress);
+    void Render(const MatchFrame& frame, float alpha);
 };
 
 extern GameApp* g_pApp;
@@ -1,6 +1,8 @@
 #include <Windows.h>
 #include <crtdbg.h>
+#include <cwchar>
 #include "Debugging/Logger.h"
+#include "D3D11RenderBackend.h"
 #include "GameApp.h"
 
 #pragma warning(disable: 28251) // Disable warning about inconsistent SAL annotations
@@ -17,6 +19,33 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
 	_CrtSetDbgFlag(tmpDbgFlag);
 #endif
 
+    // -compileshaders only compiles the shaders into their cache files (a build step) and exits
+    if (wcsstr(pCmdLine, L"-compileshaders") != nullptr)
+    {
+        AssetPack assets;
+        return (assets.Open("Data/Assets.pack") && D3D11RenderBackend::BuildShaderCache(assets)) ? 0 : 1;
+    }
+
+    // Optional: -tickrate <ticks per second>
+    int tickRate = 0;
+    const wchar_t* pTickRateArg = wcsstr(pCmdLine, L"-tickrate");
+    if (pTickRateArg != nullptr && swscanf_s(pTickRateArg, L"-tickrate %d", &tickRate) == 1 && tickRate > 0)
+        g_pApp->SetTickRate(tickRate);
+
+    // Optional: -difficulty easy|medium|hard
+    if (wcsstr(pCmdLine, L"-difficulty easy") != nullptr)
+        g_pApp->SetAIDifficulty(PaddleAIDifficulty::Easy());
+    else if (wcsstr(pCmdLine, L"-difficulty hard") != nullptr)
+        g_pApp->SetAIDifficulty(PaddleAIDifficulty::Hard());
+
+    // Optional: -simthread to run the simulation on its own thread
+    if (wcsstr(pCmdLine, L"-simthread") != nullptr)
+        g_pApp->SetThreadedSimulation(true);
+
+    // Optional: -nullrender to run without a GPU (nothing is drawn)
+    if (wcsstr(pCmdLine, L"-nullrender") != nullptr)
+        g_pApp->SetNullRendering(true);
+
     if (g_pApp->Initialize())
         g_pApp->Run();
 
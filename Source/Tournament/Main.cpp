@@ -0,0 +1,119 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include "Tournament.h"
+#include "Platform/File.h"
+#include "Threading/JobSystem.h"
+
+static void PrintUsage()
+{
+    printf(
+        "Usage: Tournament [options]\n"
+        "  -format round-robin|bracket   (default round-robin)\n"
+        "  -policies a,b,...             chase, easy, medium, hard, perfect (default all of them)\n"
+        "  -matches N                    matches per pairing (default 100)\n"
+        "  -threads N                    0 for one per core (default 0)\n"
+        "  -seed N                       (default 1)\n"
+        "  -tickrate N                   (default 120)\n"
+        "  -max-seconds N                simulated seconds before a match is a draw (default 600)\n"
+        "  -output FILE                  also write the report to FILE\n");
+}
+
+static bool ParsePolicies(const char* list, std::vector<Policy>& outPolicies)
+{
+    outPolicies.clear();
+
+    std::string names(list);
+    size_t start = 0;
+    while (start <= names.size())
+    {
+        size_t end = names.find(',', start);
+        if (end == std::string::npos)
+            end = names.size();
+
+        Policy policy;
+        std::string name = names.substr(start, end - start);
+        if (!FindPolicy(name.c_str(), policy))
+        {
+            fprintf(stderr, "Unknown policy '%s'\n", name.c_str());
+            return false;
+        }
+        outPolicies.push_back(policy);
+
+        start = end + 1;
+    }
+
+    return outPolicies.size() >= 2;
+}
+
+int main(int argc, char** argv)
+{
+    TournamentConfig config;
+    ParsePolicies("chase,easy,medium,hard,perfect", config.policies);
+
+    int numThreads = 0;
+    const char* pOutputPath = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* pOption = argv[i];
+        const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        bool valid = true;
+        if (pValue == nullptr)
+            valid = false;
+        else if (strcmp(pOption, "-format") == 0 && strcmp(pValue, "round-robin") == 0)
+            config.format = TournamentFormat::RoundRobin;
+        else if (strcmp(pOption, "-format") == 0 && strcmp(pValue, "bracket") == 0)
+            config.format = TournamentFormat::Bracket;
+        else if (strcmp(pOption, "-policies") == 0)
+            valid = ParsePolicies(pValue, config.policies);
+        else if (strcmp(pOption, "-matches") == 0)
+            valid = (config.matchesPerPairing = atoi(pValue)) > 0;
+        else if (strcmp(pOption, "-threads") == 0)
+            valid = (numThreads = atoi(pValue)) >= 0;
+        else if (strcmp(pOption, "-seed") == 0)
+            config.seed = (uint32_t)strtoul(pValue, nullptr, 10);
+        else if (strcmp(pOption, "-tickrate") == 0)
+            valid = (config.tickRate = atoi(pValue)) > 0;
+        else if (strcmp(pOption, "-max-seconds") == 0)
+            valid = (config.maxMatchSeconds = atoi(pValue)) > 0;
+        else if (strcmp(pOption, "-output") == 0)
+            pOutputPath = pValue;
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        ++i;
+    }
+
+    // One thread runs everything on the main thread; JobSystem(0) picks one worker per core
+    std::unique_ptr<JobSystem> pJobs;
+    if (numThreads != 1)
+        pJobs.reset(new JobSystem(numThreads > 1 ? (size_t)numThreads - 1 : 0));
+
+    Tournament tournament(config, pJobs.get());
+    tournament.Run();
+    tournament.PrintReport(stdout);
+
+    if (pOutputPath != nullptr)
+    {
+        FILE* pFile = OpenStdioFile(pOutputPath, "w");
+        if (pFile == nullptr)
+        {
+            fprintf(stderr, "Couldn't write %s\n", pOutputPath);
+            return 1;
+        }
+
+        tournament.PrintReport(pFile);
+        fclose(pFile);
+    }
+
+    return 0;
+}
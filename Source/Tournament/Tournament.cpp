@@ -0,0 +1,417 @@
+#include <cmath>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include "Tournament.h"
+#include "Threading/JobSystem.h"
+
+static const int RallyBucketMins[NumRallyBuckets] = { 0, 1, 2, 3, 4, 6, 8, 12, 16, 32 };
+
+bool FindPolicy(const char* name, Policy& outPolicy)
+{
+    static const struct { const char* name; PaddleAIDifficulty difficulty; } levels[] =
+    {
+        { "easy",    PaddleAIDifficulty::Easy() },
+        { "medium",  PaddleAIDifficulty::Medium() },
+        { "hard",    PaddleAIDifficulty::Hard() },
+        { "perfect", PaddleAIDifficulty::Perfect() },
+    };
+
+    outPolicy.name = name;
+    outPolicy.chase = (strcmp(name, "chase") == 0);
+    outPolicy.difficulty = PaddleAIDifficulty::Perfect();
+    if (outPolicy.chase)
+        return true;
+
+    for (const auto& level : levels)
+    {
+        if (strcmp(name, level.name) == 0)
+        {
+            outPolicy.difficulty = level.difficulty;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int RallyBucketMin(size_t bucket)
+{
+    return (bucket < NumRallyBuckets) ? RallyBucketMins[bucket] : INT_MAX;
+}
+
+static size_t GetRallyBucket(int paddleHits)
+{
+    size_t bucket = 0;
+    while (bucket + 1 < NumRallyBuckets && paddleHits >= RallyBucketMins[bucket + 1])
+        ++bucket;
+
+    return bucket;
+}
+
+static uint32_t NextRandom(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+TournamentConfig::TournamentConfig()
+{
+    format              = TournamentFormat::RoundRobin;
+    matchesPerPairing   = 100;
+    tickRate            = 120;
+    maxMatchSeconds     = 600;
+    seed                = 1;
+}
+
+Tournament::Tournament(const TournamentConfig& config, JobSystem* pJobs)
+    : m_config(config)
+{
+    m_pJobs     = pJobs;
+    m_seconds   = 0.0;
+}
+
+void Tournament::Run()
+{
+    m_results.clear();
+    m_bracket.clear();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (m_config.format == TournamentFormat::Bracket)
+    {
+        RunBracket();
+    }
+    else
+    {
+        std::vector<std::pair<int, int>> pairings;
+        for (int i = 0; i < (int)m_config.policies.size(); ++i)
+        {
+            for (int j = i + 1; j < (int)m_config.policies.size(); ++j)
+                pairings.push_back(std::make_pair(i, j));
+        }
+
+        PlayPairings(pairings);
+    }
+
+    m_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void Tournament::PlayPairings(const std::vector<std::pair<int, int>>& pairings)
+{
+    const size_t first = m_results.size();
+    const size_t matchesPerPairing = (size_t)m_config.matchesPerPairing;
+    m_results.resize(first + pairings.size() * matchesPerPairing);
+
+    auto play = [this, &pairings, first, matchesPerPairing](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            // Swap sides every match, so neither policy profits from the faster left paddle
+            const std::pair<int, int>& pairing = pairings[i / matchesPerPairing];
+            bool swap = (i % matchesPerPairing) & 1;
+
+            // The seed only depends on the match's place in the tournament, not on the thread that plays it
+            uint32_t seed = (m_config.seed * 2654435761u) ^ (uint32_t)((first + i) * 40503u + 1);
+            PlayMatch(swap ? pairing.second : pairing.first, swap ? pairing.first : pairing.second, seed, m_results[first + i]);
+        }
+    };
+
+    size_t count = m_results.size() - first;
+    if (m_pJobs != nullptr)
+        m_pJobs->ParallelFor(count, 4, play);
+    else
+        play(0, count);
+}
+
+void Tournament::PlayMatch(int policy0, int policy1, uint32_t seed, TournamentMatchResult& outResult) const
+{
+    const Policy* policies[Match::NumPaddles] = { &m_config.policies[policy0], &m_config.policies[policy1] };
+
+    // Serve towards a random side at a random angle, so the matches differ
+    uint32_t random = seed | 1;
+    MatchRules rules = m_config.rules;
+    float serveX = fabsf(ToFloat(rules.ballServeVelocity.x));
+    float serveY = 150.0f + (float)(NextRandom(random) % 201);
+    // Drawn one statement at a time: the order of function arguments is up to the compiler
+    bool serveRight = (NextRandom(random) & 1) != 0;
+    bool serveUp = (NextRandom(random) & 1) != 0;
+    rules.ballServeVelocity = Vec2(Real(serveRight ? serveX : -serveX), Real(serveUp ? serveY : -serveY));
+
+    Match match(rules);
+    PaddleAI ais[Match::NumPaddles] =
+    {
+        PaddleAI(0, policies[0]->difficulty, NextRandom(random)),
+        PaddleAI(1, policies[1]->difficulty, NextRandom(random)),
+    };
+
+    memset(&outResult, 0, sizeof(outResult));
+    outResult.policies[0] = (uint16_t)policy0;
+    outResult.policies[1] = (uint16_t)policy1;
+
+    const Real deltaTime = Real(1.0f / (float)m_config.tickRate);
+    const uint32_t maxTicks = (uint32_t)m_config.maxMatchSeconds * (uint32_t)m_config.tickRate;
+
+    int rallyHits = 0;
+    while (outResult.ticks < maxTicks && !match.IsOver())
+    {
+        MatchInput input;
+        input.start = true;
+        for (size_t p = 0; p < Match::NumPaddles; ++p)
+            input.paddles[p] = policies[p]->chase ? ChaseBallAction(match, p) : ais[p].Decide(match, deltaTime);
+
+        match.Step(input, deltaTime);
+        ++outResult.ticks;
+
+        uint32_t events = match.GetEvents();
+        if (events & MatchEvent_PaddleHit)
+            ++rallyHits;
+
+        if (events & MatchEvent_Scored)
+        {
+            ++outResult.rallies[GetRallyBucket(rallyHits)];
+            outResult.paddleHits += rallyHits;
+            rallyHits = 0;
+        }
+    }
+
+    outResult.scores[0] = (uint16_t)match.GetPaddleScore1();
+    outResult.scores[1] = (uint16_t)match.GetPaddleScore2();
+    outResult.finished = match.IsOver();
+}
+
+void Tournament::RunBracket()
+{
+    // Standard seeding: the best seeds meet as late as possible, and get the byes
+    std::vector<int> slots(1, 0);
+    while (slots.size() < m_config.policies.size())
+    {
+        std::vector<int> next;
+        for (int seed : slots)
+        {
+            next.push_back(seed);
+            next.push_back((int)slots.size() * 2 - 1 - seed);
+        }
+        slots.swap(next);
+    }
+
+    for (int& slot : slots)
+    {
+        if (slot >= (int)m_config.policies.size())
+            slot = -1;
+    }
+
+    for (int round = 0; slots.size() > 1; ++round)
+    {
+        std::vector<std::pair<int, int>> pairings;
+        size_t firstGame = m_bracket.size();
+        size_t firstResult = m_results.size();
+
+        for (size_t i = 0; i < slots.size(); i += 2)
+        {
+            BracketGame game = {};
+            game.round = round;
+            game.policies[0] = slots[i];
+            game.policies[1] = slots[i + 1];
+            game.winner = (game.policies[1] < 0) ? game.policies[0] : game.policies[1];
+            m_bracket.push_back(game);
+
+            if (game.policies[0] >= 0 && game.policies[1] >= 0)
+                pairings.push_back(std::make_pair(game.policies[0], game.policies[1]));
+        }
+
+        PlayPairings(pairings);
+
+        // Decide each game by matches won, then by point difference, then by seed
+        std::vector<int> winners;
+        size_t result = firstResult;
+        for (size_t g = firstGame; g < m_bracket.size(); ++g)
+        {
+            BracketGame& game = m_bracket[g];
+            if (game.policies[0] >= 0 && game.policies[1] >= 0)
+            {
+                int pointDifference = 0;
+                for (int m = 0; m < m_config.matchesPerPairing; ++m, ++result)
+                {
+                    const TournamentMatchResult& match = m_results[result];
+                    int side0 = (match.policies[0] == game.policies[0]) ? 0 : 1;
+                    int difference = (int)match.scores[side0] - (int)match.scores[1 - side0];
+
+                    if (match.finished)
+                        ++game.wins[difference > 0 ? 0 : 1];
+                    pointDifference += difference;
+                }
+
+                bool firstWins = (game.wins[0] != game.wins[1]) ? (game.wins[0] > game.wins[1]) :
+                    (pointDifference != 0) ? (pointDifference > 0) : (game.policies[0] < game.policies[1]);
+                game.winner = firstWins ? game.policies[0] : game.policies[1];
+            }
+
+            winners.push_back(game.winner);
+        }
+
+        slots.swap(winners);
+    }
+}
+
+void Tournament::PrintReport(FILE* pFile) const
+{
+    const char* format = (m_config.format == TournamentFormat::Bracket) ? "Bracket" : "Round robin";
+    fprintf(pFile, "%s, %zu policies, %d matches per pairing, first to %d at %d ticks/s\n\n", format,
+        m_config.policies.size(), m_config.matchesPerPairing, m_config.rules.winningScore, m_config.tickRate);
+
+    if (m_config.format == TournamentFormat::Bracket)
+        PrintBracket(pFile);
+
+    PrintWinRates(pFile);
+    PrintRallies(pFile);
+
+    uint64_t ticks = 0;
+    for (const TournamentMatchResult& result : m_results)
+        ticks += result.ticks;
+
+    size_t numThreads = (m_pJobs != nullptr) ? m_pJobs->GetNumThreads() : 1;
+    fprintf(pFile, "%zu matches in %.2f s on %zu threads: %.0f matches/s, %.2f M steps/s, %.0fx real time\n",
+        m_results.size(), m_seconds, numThreads, m_results.size() / m_seconds, ticks / m_seconds / 1e6,
+        ticks / (double)m_config.tickRate / m_seconds);
+}
+
+void Tournament::PrintBracket(FILE* pFile) const
+{
+    int round = -1;
+    for (const BracketGame& game : m_bracket)
+    {
+        if (game.round != round)
+        {
+            round = game.round;
+            fprintf(pFile, "Round %d\n", round + 1);
+        }
+
+        const char* name0 = m_config.policies[game.policies[0]].name.c_str();
+        if (game.policies[1] < 0)
+            fprintf(pFile, "  %-10s bye\n", name0);
+        else
+            fprintf(pFile, "  %-10s %3d : %-3d %-10s -> %s\n", name0, game.wins[0], game.wins[1],
+                m_config.policies[game.policies[1]].name.c_str(), m_config.policies[game.winner].name.c_str());
+    }
+
+    if (!m_bracket.empty())
+        fprintf(pFile, "Winner: %s\n\n", m_config.policies[m_bracket.back().winner].name.c_str());
+}
+
+void Tournament::PrintWinRates(FILE* pFile) const
+{
+    const size_t numPolicies = m_config.policies.size();
+
+    std::vector<PolicyStats> stats(numPolicies);
+    std::vector<uint32_t> headToHeadWins(numPolicies * numPolicies);
+    std::vector<uint32_t> headToHeadMatches(numPolicies * numPolicies);
+
+    for (const TournamentMatchResult& result : m_results)
+    {
+        for (int side = 0; side < 2; ++side)
+        {
+            int policy = result.policies[side];
+            int opponent = result.policies[1 - side];
+            int scored = result.scores[side];
+            int conceded = result.scores[1 - side];
+
+            PolicyStats& s = stats[policy];
+            ++s.matches;
+            s.pointsFor += scored;
+            s.pointsAgainst += conceded;
+            ++headToHeadMatches[policy * numPolicies + opponent];
+
+            if (!result.finished)
+            {
+                ++s.draws;
+            }
+            else if (scored > conceded)
+            {
+                ++s.wins;
+                ++headToHeadWins[policy * numPolicies + opponent];
+            }
+            else
+            {
+                ++s.losses;
+            }
+        }
+    }
+
+    std::vector<size_t> order(numPolicies);
+    for (size_t i = 0; i < numPolicies; ++i)
+        order[i] = i;
+
+    auto winRate = [&stats](size_t policy) { return stats[policy].matches ? (double)stats[policy].wins / stats[policy].matches : 0.0; };
+    std::stable_sort(order.begin(), order.end(), [&winRate](size_t a, size_t b) { return winRate(a) > winRate(b); });
+
+    fprintf(pFile, "%-10s %8s %7s %7s %7s %7s %9s\n", "Policy", "Matches", "Wins", "Losses", "Draws", "Win %", "Points");
+    for (size_t policy : order)
+    {
+        const PolicyStats& s = stats[policy];
+        fprintf(pFile, "%-10s %8u %7u %7u %7u %6.1f%% %4u:%-4u\n", m_config.policies[policy].name.c_str(),
+            s.matches, s.wins, s.losses, s.draws, 100.0 * winRate(policy), s.pointsFor, s.pointsAgainst);
+    }
+
+    fprintf(pFile, "\nWin %% of the row against the column\n%-10s", "");
+    for (size_t column : order)
+        fprintf(pFile, " %9s", m_config.policies[column].name.c_str());
+    fprintf(pFile, "\n");
+
+    for (size_t row : order)
+    {
+        fprintf(pFile, "%-10s", m_config.policies[row].name.c_str());
+        for (size_t column : order)
+        {
+            uint32_t matches = headToHeadMatches[row * numPolicies + column];
+            if (matches == 0)
+                fprintf(pFile, " %9s", "-");
+            else
+                fprintf(pFile, " %8.1f%%", 100.0 * headToHeadWins[row * numPolicies + column] / matches);
+        }
+        fprintf(pFile, "\n");
+    }
+    fprintf(pFile, "\n");
+}
+
+void Tournament::PrintRallies(FILE* pFile) const
+{
+    uint64_t rallies[NumRallyBuckets] = {};
+    uint64_t numRallies = 0;
+    uint64_t paddleHits = 0;
+
+    for (const TournamentMatchResult& result : m_results)
+    {
+        for (size_t b = 0; b < NumRallyBuckets; ++b)
+        {
+            rallies[b] += result.rallies[b];
+            numRallies += result.rallies[b];
+        }
+        paddleHits += result.paddleHits;
+    }
+
+    fprintf(pFile, "Rally lengths (paddle hits per point), %llu points, %.1f hits on average\n",
+        (unsigned long long)numRallies, numRallies ? (double)paddleHits / numRallies : 0.0);
+
+    uint64_t largest = *std::max_element(rallies, rallies + NumRallyBuckets);
+    for (size_t b = 0; b < NumRallyBuckets; ++b)
+    {
+        char label[16];
+        int min = RallyBucketMin(b);
+        int max = RallyBucketMin(b + 1) - 1;
+        if (min == max)
+            snprintf(label, sizeof(label), "%d", min);
+        else if (b + 1 == NumRallyBuckets)
+            snprintf(label, sizeof(label), "%d+", min);
+        else
+            snprintf(label, sizeof(label), "%d-%d", min, max);
+
+        int bar = largest ? (int)(40 * rallies[b] / largest) : 0;
+        fprintf(pFile, "%7s %9llu %5.1f%% %.*s\n", label, (unsigned long long)rallies[b],
+            numRallies ? 100.0 * rallies[b] / numRallies : 0.0, bar, "########################################");
+    }
+    fprintf(pFile, "\n");
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "AI/PaddleAI.h"
+
+class JobSystem;
+
+// Headless AI tournaments: every match is played under the game's rules until one side reaches the
+// winning score (the point where GameApp goes back to WaitingForPlayers and quits), spread over all
+// cores by the job system.
+
+// A computer player: the original chase AI, or a PaddleAI at some difficulty
+struct Policy
+{
+    std::string         name;
+    bool                chase;
+    PaddleAIDifficulty  difficulty;
+};
+
+// Policies by name: chase, easy, medium, hard, perfect
+bool FindPolicy(const char* name, Policy& outPolicy);
+
+enum class TournamentFormat
+{
+    RoundRobin,     // Every policy plays every other one
+    Bracket,        // Single elimination, seeded in the order the policies are given
+};
+
+struct TournamentConfig
+{
+    std::vector<Policy> policies;
+    TournamentFormat    format;
+    MatchRules          rules;
+    int                 matchesPerPairing;  // Policies swap sides every match
+    int                 tickRate;
+    int                 maxMatchSeconds;    // Simulated time after which a match is called a draw
+    uint32_t            seed;
+
+    TournamentConfig();
+};
+
+// Rally length = paddle hits during a point. Bucket b holds the lengths in [RallyBucketMin(b), RallyBucketMin(b + 1)).
+static const size_t NumRallyBuckets = 10;
+int RallyBucketMin(size_t bucket);
+
+struct TournamentMatchResult
+{
+    uint16_t    policies[2];        // Left and right paddle
+    uint16_t    scores[2];
+    bool        finished;           // False if the match hit maxMatchSeconds
+    uint32_t    ticks;
+    uint32_t    paddleHits;         // During the points played out, not the one cut off by a draw
+    uint16_t    rallies[NumRallyBuckets];
+};
+
+struct PolicyStats
+{
+    uint32_t    matches;
+    uint32_t    wins;
+    uint32_t    losses;
+    uint32_t    draws;
+    uint32_t    pointsFor;
+    uint32_t    pointsAgainst;
+};
+
+struct BracketGame
+{
+    int         round;
+    int         policies[2];        // -1 for a bye
+    int         wins[2];
+    int         winner;
+};
+
+class Tournament
+{
+    TournamentConfig                    m_config;
+    JobSystem*                          m_pJobs;
+
+    std::vector<TournamentMatchResult>  m_results;
+    std::vector<BracketGame>            m_bracket;
+    double                              m_seconds;
+
+public:
+    // Without a job system every match is played on the calling thread
+    Tournament(const TournamentConfig& config, JobSystem* pJobs);
+
+    void Run();
+
+    // Win rates, rally lengths and throughput
+    void PrintReport(FILE* pFile) const;
+
+private:
+    // Plays matchesPerPairing matches for each pairing, appending them to m_results
+    void PlayPairings(const std::vector<std::pair<int, int>>& pairings);
+    void PlayMatch(int policy0, int policy1, uint32_t seed, TournamentMatchResult& outResult) const;
+
+    void RunBracket();
+
+    void PrintBracket(FILE* pFile) const;
+    void PrintWinRates(FILE* pFile) const;
+    void PrintRallies(FILE* pFile) const;
+};